@@ -1189,6 +1189,13 @@ calculate_hashes(const char *filename)
     }
 }
 
+static gpointer
+calculate_hashes_thread(gpointer data)
+{
+    calculate_hashes((const char *)data);
+    return NULL;
+}
+
 static int
 process_cap_file(const char *filename, gboolean need_separator)
 {
@@ -1216,6 +1223,7 @@ process_cap_file(const char *filename, gboolean need_separator)
     order_t               order = IN_ORDER;
     guint                 i;
     wtapng_iface_descriptions_t *idb_info;
+    GThread              *hash_thread = NULL;
 
     cf_info.wth = wtap_open_offline(filename, WTAP_TYPE_AUTO, &err, &err_info, FALSE);
     if (!cf_info.wth) {
@@ -1227,8 +1235,18 @@ process_cap_file(const char *filename, gboolean need_separator)
      * Calculate the checksums. Do this after wtap_open_offline, so we don't
      * bother calculating them for files that are not known capture types
      * where we wouldn't print them anyway.
+     *
+     * Hashing reads the whole file, as does the packet loop below;
+     * do it on a separate thread so that the two reads overlap
+     * rather than taking turns.  The hash thread only touches the
+     * file_* hash strings, hd and hash_buf, none of which are used
+     * until it has been joined.
      */
-    calculate_hashes(filename);
+    if (cap_file_hashes) {
+        hash_thread = g_thread_new("capinfos hash", calculate_hashes_thread, (gpointer)filename);
+    } else {
+        calculate_hashes(filename);
+    }
 
     if (need_separator && long_report) {
         printf("\n");
@@ -1362,6 +1380,11 @@ process_cap_file(const char *filename, gboolean need_separator)
     wtap_rec_cleanup(&rec);
     ws_buffer_free(&buf);
 
+    /* Wait for the hashes before anything below can print or return. */
+    if (hash_thread != NULL) {
+        g_thread_join(hash_thread);
+    }
+
     /*
      * Get IDB info strings.
      * We do this at the end, so we can get information for all IDBs in
@@ -139,6 +139,7 @@ static struct select_item     selectfrm[MAX_SELECTIONS];
 static guint                  max_selected              = 0;
 static gboolean               keep_em                   = FALSE;
 static int                    out_file_type_subtype     = WTAP_FILE_TYPE_SUBTYPE_UNKNOWN;
+static wtap_compression_type  out_compression_type      = WTAP_UNCOMPRESSED;
 static int                    out_frame_type            = -2; /* Leave frame type alone */
 static gboolean               verbose                   = FALSE; /* Not so verbose         */
 static struct time_adjustment time_adj                  = {NSTIME_INIT_ZERO, 0}; /* no adjustment */
@@ -818,6 +819,9 @@ print_usage(FILE *output)
     fprintf(output, "                         <seconds per file> each.\n");
     fprintf(output, "  -F <capture type>      set the output file type; default is pcapng.\n");
     fprintf(output, "                         An empty \"-F\" option will list the file types.\n");
+    fprintf(output, "  --compress <type>      compress the output file using the given compression\n");
+    fprintf(output, "                         type; default is none. An empty \"--compress\"\n");
+    fprintf(output, "                         option will list the compression types.\n");
     fprintf(output, "  -T <encap type>        set the output file encapsulation type; default is the\n");
     fprintf(output, "                         same as the input file. An empty \"-T\" option will\n");
     fprintf(output, "                         list the encapsulation types.\n");
@@ -878,6 +882,21 @@ list_capture_types(FILE *stream) {
     g_array_free(writable_type_subtypes, TRUE);
 }
 
+static void
+list_output_compression_types(FILE *stream) {
+    GSList *output_compression_types;
+
+    fprintf(stream, "editcap: The available compression types for the \"--compress\" flag are:\n");
+    fprintf(stream, "    none\n");
+    output_compression_types = wtap_get_all_output_compression_type_names_list();
+    for (GSList *compression_type = output_compression_types;
+         compression_type != NULL;
+         compression_type = g_slist_next(compression_type)) {
+        fprintf(stream, "    %s\n", (const char *)compression_type->data);
+    }
+    g_slist_free(output_compression_types);
+}
+
 static void
 list_encap_types(FILE *stream) {
     int i;
@@ -976,10 +995,10 @@ editcap_dump_open(const char *filename, const wtap_dump_params *params,
 
     if (strcmp(filename, "-") == 0) {
         /* Write to the standard output. */
-        pdh = wtap_dump_open_stdout(out_file_type_subtype, WTAP_UNCOMPRESSED,
+        pdh = wtap_dump_open_stdout(out_file_type_subtype, out_compression_type,
                                     params, err, err_info);
     } else {
-        pdh = wtap_dump_open(filename, out_file_type_subtype, WTAP_UNCOMPRESSED,
+        pdh = wtap_dump_open(filename, out_file_type_subtype, out_compression_type,
                              params, err, err_info);
     }
     if (pdh == NULL)
@@ -1127,6 +1146,7 @@ main(int argc, char *argv[])
 #define LONGOPT_DISCARD_ALL_SECRETS  LONGOPT_BASE_APPLICATION+5
 #define LONGOPT_CAPTURE_COMMENT      LONGOPT_BASE_APPLICATION+6
 #define LONGOPT_DISCARD_CAPTURE_COMMENT LONGOPT_BASE_APPLICATION+7
+#define LONGOPT_COMPRESS             LONGOPT_BASE_APPLICATION+8
 
     static const struct ws_option long_options[] = {
         {"novlan", ws_no_argument, NULL, LONGOPT_NO_VLAN},
@@ -1138,6 +1158,7 @@ main(int argc, char *argv[])
         {"version", ws_no_argument, NULL, 'V'},
         {"capture-comment", ws_required_argument, NULL, LONGOPT_CAPTURE_COMMENT},
         {"discard-capture-comment", ws_no_argument, NULL, LONGOPT_DISCARD_CAPTURE_COMMENT},
+        {"compress", ws_required_argument, NULL, LONGOPT_COMPRESS},
         {0, 0, 0, 0 }
     };
 
@@ -1299,6 +1320,19 @@ main(int argc, char *argv[])
             break;
         }
 
+        case LONGOPT_COMPRESS:
+        {
+            out_compression_type = wtap_name_to_compression_type(ws_optarg);
+            if (out_compression_type == WTAP_UNKNOWN_COMPRESSION) {
+                fprintf(stderr, "editcap: \"%s\" isn't a valid output compression mode\n\n",
+                        ws_optarg);
+                list_output_compression_types(stderr);
+                ret = INVALID_OPTION;
+                goto clean_exit;
+            }
+            break;
+        }
+
         case 'a':
         {
             guint frame_number;
@@ -1531,6 +1565,9 @@ main(int argc, char *argv[])
             case'T':
                 list_encap_types(stdout);
                 break;
+            case LONGOPT_COMPRESS:
+                list_output_compression_types(stdout);
+                break;
             default:
                 if (opt == '?') {
                     fprintf(stderr, "editcap: invalid option -- '%c'\n", ws_optopt);
@@ -1561,6 +1598,14 @@ main(int argc, char *argv[])
       out_file_type_subtype = wtap_pcapng_file_type_subtype();
     }
 
+    if (out_compression_type != WTAP_UNCOMPRESSED &&
+        !wtap_dump_can_compress(out_file_type_subtype)) {
+        fprintf(stderr, "editcap: %s files can't be written compressed\n",
+                wtap_file_type_subtype_name(out_file_type_subtype));
+        ret = INVALID_OPTION;
+        goto clean_exit;
+    }
+
     if (err_prob >= 0.0) {
         if (!valid_seed) {
             seed = (unsigned int) (time(NULL) + ws_getpid());
@@ -224,6 +224,7 @@ static wmem_map_t *eth_hashtable = NULL;
 // Maps guint -> serv_port_t*
 static wmem_map_t *serv_port_hashtable = NULL;
 static GHashTable *enterprises_hashtable = NULL;
+static gboolean    enterprises_loaded = FALSE;
 
 static subnet_length_entry_t subnet_length_entries[SUBNETLENGTHSIZE]; /* Ordered array of entries */
 static gboolean have_subnet_entry = FALSE;
@@ -913,7 +914,6 @@ initialize_enterprises(void)
     if (g_enterprises_path == NULL) {
         g_enterprises_path = get_datafile_path(ENAME_ENTERPRISES);
     }
-    parse_enterprises_file(g_enterprises_path);
 
     if (g_penterprises_path == NULL) {
         /* Check profile directory before personal configuration */
@@ -923,12 +923,28 @@ initialize_enterprises(void)
             g_penterprises_path = get_persconffile_path(ENAME_ENTERPRISES, FALSE);
         }
     }
+
+    /*
+     * The enterprises file has tens of thousands of entries and most
+     * runs never look one up, so it's only read on the first lookup.
+     */
+    enterprises_loaded = FALSE;
+}
+
+static void
+load_enterprises(void)
+{
+    parse_enterprises_file(g_enterprises_path);
     parse_enterprises_file(g_penterprises_path);
+    enterprises_loaded = TRUE;
 }
 
 const gchar *
 try_enterprises_lookup(guint32 value)
 {
+    if (!enterprises_loaded)
+        load_enterprises();
+
     return (const gchar *)g_hash_table_lookup(enterprises_hashtable, GUINT_TO_POINTER(value));
 }
 
@@ -961,6 +977,7 @@ enterprises_cleanup(void)
     ws_assert(enterprises_hashtable);
     g_hash_table_destroy(enterprises_hashtable);
     enterprises_hashtable = NULL;
+    enterprises_loaded = FALSE;
     ws_assert(g_enterprises_path);
     g_free(g_enterprises_path);
     g_enterprises_path = NULL;
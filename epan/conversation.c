@@ -48,6 +48,16 @@ struct conversation_key {
     guint32	port2;
 };
 
+/*
+ * Per-protocol functions for freeing conversation data when an idle
+ * conversation is expired, keyed by protocol ID.
+ */
+static wmem_map_t *conversation_data_cleanup_funcs = NULL;
+
+typedef struct {
+    conversation_data_cleanup_func cleanup;
+} conversation_data_cleanup_t;
+
 /*
  * Hash table of hash tables for conversations identified by element lists.
  */
@@ -695,10 +705,13 @@ conversation_insert_into_hashtable(wmem_map_t *hashtable, conversation_t *conv)
                 ;
 
             if (NULL==prev) {
-                /* Changing the head of the chain */
+                /* Changing the head of the chain. Replace the map
+                 * entry rather than just its value, so that the key
+                 * stored in the map is always the head's own key. */
                 conv->next = chain_head;
                 conv->last = chain_tail;
                 chain_head->last = NULL;
+                wmem_map_steal(hashtable, chain_head->key_ptr);
                 wmem_map_insert(hashtable, conv->key_ptr, conv);
             }
             else {
@@ -722,6 +735,11 @@ conversation_remove_from_hashtable(wmem_map_t *hashtable, conversation_t *conv)
 
     chain_head = (conversation_t *)wmem_map_lookup(hashtable, conv->key_ptr);
 
+    if (chain_head == NULL) {
+        /* Not in this table, e.g. because it was expired. */
+        return;
+    }
+
     if (conv == chain_head) {
         /* We are currently the front of the chain */
         if (NULL == conv->next) {
@@ -741,6 +759,8 @@ conversation_remove_from_hashtable(wmem_map_t *hashtable, conversation_t *conv)
             else
                 chain_head->latest_found = conv->latest_found;
 
+            /* The map still holds our key; hand it the new head's. */
+            wmem_map_steal(hashtable, conv->key_ptr);
             wmem_map_insert(hashtable, chain_head->key_ptr, chain_head);
         }
     }
@@ -839,6 +859,7 @@ conversation_t *conversation_new_full(const guint32 setup_frame, conversation_el
     conversation_t *conversation = wmem_new0(wmem_file_scope(), conversation_t);
     conversation->conv_index = new_index;
     conversation->setup_frame = conversation->last_frame = setup_frame;
+    conversation->last_activity = setup_frame;
 
     new_index++;
 
@@ -990,6 +1011,7 @@ conversation_new(const guint32 setup_frame, const address *addr1, const address
 
     conversation->conv_index = new_index;
     conversation->setup_frame = conversation->last_frame = setup_frame;
+    conversation->last_activity = setup_frame;
 
     /* set the options and key pointer */
     conversation->options = options;
@@ -1010,6 +1032,7 @@ conversation_new_by_id(const guint32 setup_frame, const endpoint_type etype, con
     conversation_t *conversation = wmem_new0(wmem_file_scope(), conversation_t);
     conversation->conv_index = new_index;
     conversation->setup_frame = conversation->last_frame = setup_frame;
+    conversation->last_activity = setup_frame;
 
     new_index++;
 
@@ -1106,21 +1129,29 @@ static conversation_t *conversation_lookup_hashtable(wmem_map_t *conversation_ha
     if (chain_head && (chain_head->setup_frame <= frame_num)) {
         match = chain_head;
 
-        if (chain_head->last && (chain_head->last->setup_frame <= frame_num))
-            return chain_head->last;
-
-        if (chain_head->latest_found && (chain_head->latest_found->setup_frame <= frame_num))
-            match = chain_head->latest_found;
+        if (chain_head->last && (chain_head->last->setup_frame <= frame_num)) {
+            match = chain_head->last;
+        } else {
+            if (chain_head->latest_found && (chain_head->latest_found->setup_frame <= frame_num))
+                match = chain_head->latest_found;
 
-        for (convo = match; convo && convo->setup_frame <= frame_num; convo = convo->next) {
-            if (convo->setup_frame > match->setup_frame) {
-                match = convo;
+            for (convo = match; convo && convo->setup_frame <= frame_num; convo = convo->next) {
+                if (convo->setup_frame > match->setup_frame) {
+                    match = convo;
+                }
             }
+
+            chain_head->latest_found = match;
         }
-    }
 
-    if (match) {
-        chain_head->latest_found = match;
+        /*
+         * Every lookup counts as activity, whichever of the find_conversation
+         * variants it came through, so conversation_expire_before() doesn't
+         * drop a conversation that is still in use.
+         */
+        if (frame_num > match->last_activity) {
+            match->last_activity = frame_num;
+        }
     }
 
     return match;
@@ -1612,6 +1643,129 @@ conversation_delete_proto_data(conversation_t *conv, const int proto)
         wmem_tree_remove32(conv->data_list, proto);
 }
 
+void
+conversation_register_data_cleanup(const int proto, conversation_data_cleanup_func cleanup)
+{
+    conversation_data_cleanup_t *entry;
+
+    if (conversation_data_cleanup_funcs == NULL) {
+        conversation_data_cleanup_funcs = wmem_map_new(wmem_epan_scope(), g_direct_hash, g_direct_equal);
+    }
+
+    entry = wmem_new(wmem_epan_scope(), conversation_data_cleanup_t);
+    entry->cleanup = cleanup;
+    wmem_map_insert(conversation_data_cleanup_funcs, GINT_TO_POINTER(proto), entry);
+}
+
+typedef struct {
+    wmem_map_t *hashtable;
+    conversation_t *conv;
+} conversation_expired_t;
+
+typedef struct {
+    guint32 frame_num;
+    wmem_map_t *hashtable;
+    GArray *expired;    /* conversation_expired_t */
+} conversation_expire_data_t;
+
+static void
+conversation_collect_expired(gpointer key _U_, gpointer value, gpointer user_data)
+{
+    conversation_expire_data_t *data = (conversation_expire_data_t *)user_data;
+    conversation_expired_t expired;
+
+    expired.hashtable = data->hashtable;
+    for (expired.conv = (conversation_t *)value; expired.conv != NULL; expired.conv = expired.conv->next) {
+        if (expired.conv->last_activity < data->frame_num) {
+            g_array_append_val(data->expired, expired);
+        }
+    }
+}
+
+static void
+conversation_collect_expired_element_list(gpointer key _U_, gpointer value, gpointer user_data)
+{
+    conversation_expire_data_t *data = (conversation_expire_data_t *)user_data;
+
+    data->hashtable = (wmem_map_t *)value;
+    wmem_map_foreach(data->hashtable, conversation_collect_expired, data);
+}
+
+static gboolean
+conversation_cleanup_proto_data(const void *key, void *value, void *userdata)
+{
+    conversation_data_cleanup_t *entry;
+
+    entry = (conversation_data_cleanup_t *)wmem_map_lookup(conversation_data_cleanup_funcs, key);
+    if (entry != NULL && value != NULL) {
+        entry->cleanup((conversation_t *)userdata, value);
+    }
+
+    return FALSE;
+}
+
+/*
+ * Free the data an expired conversation owns. The conversation_t and its key
+ * are left in file scope, as dissectors keep pointers to conversations in
+ * their own tables (often as lookup keys) and may still read the key.
+ */
+static void
+conversation_free(conversation_t *conv)
+{
+    if (conv->data_list != NULL) {
+        if (conversation_data_cleanup_funcs != NULL) {
+            wmem_tree_foreach(conv->data_list, conversation_cleanup_proto_data, conv);
+        }
+        wmem_tree_destroy(conv->data_list, FALSE, FALSE);
+        conv->data_list = NULL;
+    }
+    /* Conversations created from a template share their dissector tree,
+     * so only drop our reference to it. */
+    conv->dissector_tree = NULL;
+}
+
+guint
+conversation_expire_before(const guint32 frame_num)
+{
+    wmem_map_t *addr_port_tables[] = {
+        conversation_hashtable_exact_addr_port,
+        conversation_hashtable_no_addr2,
+        conversation_hashtable_no_port2,
+        conversation_hashtable_no_addr2_or_port2,
+    };
+    conversation_expire_data_t data;
+    conversation_expired_t *expired;
+    guint i;
+
+    data.frame_num = frame_num;
+    data.expired = g_array_new(FALSE, FALSE, sizeof(conversation_expired_t));
+
+    /*
+     * Collect first and unlink afterwards; removing a conversation
+     * can replace the map entry for its chain.
+     */
+    for (i = 0; i < G_N_ELEMENTS(addr_port_tables); i++) {
+        data.hashtable = addr_port_tables[i];
+        wmem_map_foreach(data.hashtable, conversation_collect_expired, &data);
+    }
+    wmem_map_foreach(conversation_hashtable_element_list, conversation_collect_expired_element_list, &data);
+
+    for (i = 0; i < data.expired->len; i++) {
+        expired = &g_array_index(data.expired, conversation_expired_t, i);
+        conversation_remove_from_hashtable(expired->hashtable, expired->conv);
+    }
+    for (i = 0; i < data.expired->len; i++) {
+        expired = &g_array_index(data.expired, conversation_expired_t, i);
+        conversation_free(expired->conv);
+    }
+
+    i = data.expired->len;
+    g_array_free(data.expired, TRUE);
+
+    DPRINT(("expired %u conversations last seen before frame #%u", i, frame_num));
+    return i;
+}
+
 void
 conversation_set_dissector_from_frame_number(conversation_t *conversation,
         const guint32 starting_frame_num, const dissector_handle_t handle)
@@ -106,6 +106,7 @@ typedef struct conversation {
     guint32 setup_frame;		/** frame number that setup this conversation */
     /* Assume that setup_frame is also the lowest frame number for now. */
     guint32 last_frame;		/** highest frame number in this conversation */
+    guint32 last_activity;		/** highest frame number this conversation was looked up for */
     wmem_tree_t *data_list;		/** list of data associated with conversation */
     wmem_tree_t *dissector_tree;	/** tree containing protocol dissector client associated with conversation */
     guint	options;		/** wildcard flags */
@@ -289,6 +290,32 @@ WS_DLL_PUBLIC void *conversation_get_proto_data(const conversation_t *conv, cons
  */
 WS_DLL_PUBLIC void conversation_delete_proto_data(conversation_t *conv, const int proto);
 
+/** Function used to free a protocol's conversation data when the
+ * conversation is expired by conversation_expire_before().
+ * It must not add, delete, or look up conversations or their data.
+ */
+typedef void (*conversation_data_cleanup_func)(conversation_t *conv, void *proto_data);
+
+/** Register a function that frees the data a protocol associates with
+ * conversations. Protocols without one keep their data in file scope
+ * until the capture file is closed.
+ * @param proto Protocol ID.
+ * @param cleanup Function called for each expired conversation carrying data for proto.
+ */
+WS_DLL_PUBLIC void conversation_register_data_cleanup(const int proto, conversation_data_cleanup_func cleanup);
+
+/** Remove every conversation not looked up since before frame_num from the
+ * conversation tables and free its data and dissector list.
+ * This lets a long-running single-pass dissection drop state for flows that
+ * have gone idle. The conversation_t and its key stay allocated, as
+ * dissectors may still hold pointers to it, but it no longer has any data.
+ * This must only be called between packets, and only when no later pass
+ * will revisit the frames those conversations covered.
+ * @param frame_num Conversations last seen before this frame are expired.
+ * @return The number of conversations removed.
+ */
+WS_DLL_PUBLIC guint conversation_expire_before(const guint32 frame_num);
+
 WS_DLL_PUBLIC void conversation_set_dissector(conversation_t *conversation, const dissector_handle_t handle);
 
 WS_DLL_PUBLIC void conversation_set_dissector_from_frame_number(conversation_t *conversation,
@@ -189,6 +189,9 @@ guint conversation_table_get_num(void)
 /** Compute the hash value for two given address/port pairs.
  * (Parameter type is gconstpointer for GHashTable compatibility.)
  *
+ * The hash doesn't depend on the order of the two endpoints, so that
+ * both directions of a conversation can be found with a single lookup.
+ *
  * @param v Conversation Key. MUST point to a conv_key_t struct.
  * @return Computed key hash.
  */
@@ -196,16 +199,12 @@ static guint
 conversation_hash(gconstpointer v)
 {
     const conv_key_t *key = (const conv_key_t *)v;
-    guint hash_val;
+    guint hash_val1, hash_val2;
 
-    hash_val = 0;
-    hash_val = add_address_to_hash(hash_val, &key->addr1);
-    hash_val += key->port1;
-    hash_val = add_address_to_hash(hash_val, &key->addr2);
-    hash_val += key->port2;
-    hash_val ^= key->conv_id;
+    hash_val1 = add_address_to_hash(0, &key->addr1) + key->port1;
+    hash_val2 = add_address_to_hash(0, &key->addr2) + key->port2;
 
-    return hash_val;
+    return (hash_val1 + hash_val2) ^ key->conv_id;
 }
 
 /** Compare two conversation keys for an exact match.
@@ -593,8 +592,9 @@ add_conversation_table_data_with_conv_id(
                                               NULL);              /* value_destroy_func */
 
     } else { /* try to find it among the existing known conversations */
-        /* first, check in the fwd conversations */
+        /* conversation_equal() matches both directions */
         conv_key_t existing_key;
+        gpointer found_key;
         gpointer conversation_idx_hash_val;
 
         existing_key.addr1 = *src;
@@ -602,21 +602,13 @@ add_conversation_table_data_with_conv_id(
         existing_key.port1 = src_port;
         existing_key.port2 = dst_port;
         existing_key.conv_id = conv_id;
-        if (g_hash_table_lookup_extended(ch->hashtable, &existing_key, NULL, &conversation_idx_hash_val)) {
+        if (g_hash_table_lookup_extended(ch->hashtable, &existing_key, &found_key, &conversation_idx_hash_val)) {
+            const conv_key_t *ck = (const conv_key_t *)found_key;
+
             conv_item = &g_array_index(ch->conv_array, conv_item_t, GPOINTER_TO_UINT(conversation_idx_hash_val));
-        }
-        if (conv_item == NULL) {
-            /* then, check in the rev conversations if not found in 'fwd' */
-            existing_key.addr1 = *dst;
-            existing_key.addr2 = *src;
-            existing_key.port1 = dst_port;
-            existing_key.port2 = src_port;
-            if (g_hash_table_lookup_extended(ch->hashtable, &existing_key, NULL, &conversation_idx_hash_val)) {
-                conv_item = &g_array_index(ch->conv_array, conv_item_t, GPOINTER_TO_UINT(conversation_idx_hash_val));
-            }
-        } else {
-            /* a conversation was found in this same fwd direction */
-            is_fwd_direction = TRUE;
+            /* was it found in this same fwd direction? */
+            is_fwd_direction = ck->port1 == src_port && addresses_equal(&ck->addr1, src) &&
+                               ck->port2 == dst_port && addresses_equal(&ck->addr2, dst);
         }
     }
 
@@ -1608,6 +1608,47 @@ init_tcp_conversation_data(packet_info *pinfo, int direction)
     return tcpd;
 }
 
+static void
+free_tcp_flow_data(tcp_flow_t *flow)
+{
+    tcp_unacked_t *ual, *next_ual;
+
+    wmem_tree_destroy(flow->multisegment_pdus, FALSE, TRUE);
+    if (flow->ooo_segments) {
+        wmem_destroy_list(flow->ooo_segments);
+    }
+    if (flow->tcp_analyze_seq_info) {
+        for (ual = flow->tcp_analyze_seq_info->segments; ual; ual = next_ual) {
+            next_ual = ual->next;
+            wmem_free(wmem_file_scope(), ual);
+        }
+        wmem_free(wmem_file_scope(), flow->tcp_analyze_seq_info);
+    }
+    if (flow->process_info) {
+        wmem_free(wmem_file_scope(), flow->process_info->username);
+        wmem_free(wmem_file_scope(), flow->process_info->command);
+        wmem_free(wmem_file_scope(), flow->process_info);
+    }
+}
+
+/* Called when an idle TCP conversation is expired. */
+static void
+free_tcp_conversation_data(conversation_t *conv _U_, void *proto_data)
+{
+    struct tcp_analysis *tcpd = (struct tcp_analysis *)proto_data;
+
+    /* MPTCP subflows are linked from their connection and other
+     * subflows; leave them to the file scope. */
+    if (tcpd->mptcp_analysis) {
+        return;
+    }
+
+    free_tcp_flow_data(&tcpd->flow1);
+    free_tcp_flow_data(&tcpd->flow2);
+    wmem_tree_destroy(tcpd->acked_table, FALSE, TRUE);
+    wmem_free(wmem_file_scope(), tcpd);
+}
+
 /* setup meta as well */
 static void
 mptcp_init_subflow(tcp_flow_t *flow)
@@ -9131,6 +9172,7 @@ proto_register_tcp(void)
         &read_seq_as_syn_cookie);
 
     register_init_routine(tcp_init);
+    conversation_register_data_cleanup(proto_tcp, free_tcp_conversation_data);
     reassembly_table_register(&tcp_reassembly_table,
                           &tcp_reassembly_table_functions);
 
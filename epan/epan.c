@@ -108,6 +108,14 @@ static GSList *epan_plugin_register_all_handoffs = NULL;
 
 static wmem_allocator_t *pinfo_pool_cache = NULL;
 
+/*
+ * The session whose dissection state is currently set up.  Conversations,
+ * reassembly tables, the file scope and so on are still process-global and
+ * are reset by init_dissection(), so only one session can be live at a time;
+ * a second one would silently wipe the first one's state.
+ */
+static epan_t *live_session = NULL;
+
 /* Global variables holding the content of the corresponding environment variable
  * to save fetching it repeatedly.
  */
@@ -442,14 +450,19 @@ epan_t *
 epan_new(struct packet_provider_data *prov,
     const struct packet_provider_funcs *funcs)
 {
-	epan_t *session = g_slice_new0(epan_t);
+	epan_t *session;
+
+	ws_assert(live_session == NULL);
 
+	session = g_slice_new0(epan_t);
 	session->prov = prov;
 	session->funcs = *funcs;
 
 	/* XXX, it should take session as param */
 	init_dissection();
 
+	live_session = session;
+
 	return session;
 }
 
@@ -498,9 +511,13 @@ void
 epan_free(epan_t *session)
 {
 	if (session) {
+		ws_assert(session == live_session);
+
 		/* XXX, it should take session as param */
 		cleanup_dissection();
 
+		live_session = NULL;
+
 		g_slice_free(epan_t, session);
 	}
 }
@@ -40,6 +40,7 @@
 #include <epan/range.h>
 
 #include <wsutil/str_util.h>
+#include <wsutil/time_util.h>
 #include <wsutil/wslog.h>
 #include <wsutil/ws_assert.h>
 
@@ -81,6 +82,16 @@ struct data_source {
  *
  * "protocol" is the protocol associated with the dissector table. Used
  * for determining dependencies.
+ *
+ * "uint_index" is, for FT_UINT8 and FT_UINT16 tables that are looked
+ * up frequently, an array of "uint_index_size" entries, indexed by the
+ * uint value, mirroring the contents of "hash_table" so that a lookup
+ * is a single array access.  It is built lazily once "uint_lookups"
+ * reaches DTBL_UINT_INDEX_THRESHOLD, kept in sync by single-entry
+ * changes (including "Decode As"), and discarded by bulk changes so
+ * that it is rebuilt on demand.  "uint_index_size" is 0 for tables that
+ * can't be indexed, including tables in which a value wider than the
+ * table type has been registered.
  */
 struct dissector_table {
 	GHashTable	*hash_table;
@@ -91,8 +102,18 @@ struct dissector_table {
 	protocol_t	*protocol;
 	GHashFunc	hash_func;
 	gboolean	supports_decode_as;
+	dtbl_entry_t	**uint_index;
+	guint32		uint_index_size;
+	guint		uint_lookups;
 };
 
+/*
+ * Number of lookups in an FT_UINT8 or FT_UINT16 dissector table after
+ * which a direct index is built for it; tables only consulted a few
+ * times don't pay for a 64K-entry array.
+ */
+#define DTBL_UINT_INDEX_THRESHOLD	1024
+
 /*
  * Dissector tables. const char * -> dissector_table *
  */
@@ -159,10 +180,28 @@ destroy_depend_dissector_list(void *data)
 struct heur_dissector_list {
 	protocol_t	*protocol;
 	GSList		*dissectors;
+	GSList		*registered;	/* the same entries, in registration order */
 };
 
 static GHashTable *heur_dissector_lists = NULL;
 
+/*
+ * Dissector profiling.  When enabled, every call made through a dissector
+ * handle is timed and accounted to the handle's protocol.
+ * protocol_t * -> dissector_profile_t *
+ */
+static gboolean    dissector_profiling = FALSE;
+static GHashTable *dissector_profiles = NULL;
+
+typedef struct dissector_profile_usage {
+	guint64 ns;
+	guint64 packet_bytes;
+	guint64 file_bytes;
+} dissector_profile_usage_t;
+
+/* Used by sub-dissectors of the dissector currently being profiled. */
+static dissector_profile_usage_t dissector_profile_child;
+
 /* Name hashtables for fast detection of duplicate names */
 static GHashTable* heuristic_short_names  = NULL;
 
@@ -182,9 +221,31 @@ destroy_heuristic_dissector_list(void *data)
 	GSList **list = &(dissector_list->dissectors);
 
 	g_slist_free_full(*list, destroy_heuristic_dissector_entry);
+	g_slist_free(dissector_list->registered);
 	g_slice_free(struct heur_dissector_list, dissector_list);
 }
 
+/*
+ * Undo the reordering done by dissector_try_heuristic() and clear the
+ * counters it is based on, so that a new capture file doesn't inherit the
+ * order learned from the previous one.
+ */
+static void
+heur_dissector_list_reset_order(gpointer key _U_, gpointer value, gpointer user_data _U_)
+{
+	heur_dissector_list_t sub_dissectors = (heur_dissector_list_t)value;
+	GSList *entry;
+
+	g_slist_free(sub_dissectors->dissectors);
+	sub_dissectors->dissectors = g_slist_copy(sub_dissectors->registered);
+	for (entry = sub_dissectors->dissectors; entry != NULL; entry = entry->next) {
+		heur_dtbl_entry_t *hdtbl_entry = (heur_dtbl_entry_t *)entry->data;
+
+		hdtbl_entry->tries = 0;
+		hdtbl_entry->hits = 0;
+	}
+}
+
 static void
 destroy_dissector_table(void *data)
 {
@@ -192,6 +253,7 @@ destroy_dissector_table(void *data)
 
 	g_hash_table_destroy(table->hash_table);
 	g_slist_free(table->dissector_handles);
+	g_free(table->uint_index);
 	g_slice_free(struct dissector_table, data);
 }
 
@@ -214,6 +276,9 @@ packet_init(void)
 			NULL, destroy_heuristic_dissector_list);
 
 	heuristic_short_names  = g_hash_table_new(g_str_hash, g_str_equal);
+
+	dissector_profiles = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+			NULL, g_free);
 }
 
 void
@@ -261,6 +326,7 @@ packet_cleanup(void)
 	g_hash_table_destroy(depend_dissector_lists);
 	g_hash_table_destroy(heur_dissector_lists);
 	g_hash_table_destroy(heuristic_short_names);
+	g_hash_table_destroy(dissector_profiles);
 	g_slist_foreach(shutdown_routines, &call_routine, NULL);
 	g_slist_free(shutdown_routines);
 	if (postdissectors) {
@@ -329,6 +395,9 @@ init_dissection(void)
 	/* Initialize protocol-specific variables. */
 	g_slist_foreach(init_routines, &call_routine, NULL);
 
+	/* Start every heuristic list over in registration order. */
+	g_hash_table_foreach(heur_dissector_lists, heur_dissector_list_reset_order, NULL);
+
 	/* Initialize the stream-handling tables */
 	stream_init();
 
@@ -791,6 +860,106 @@ remove_last_layer(packet_info *pinfo, gboolean reduce_count)
 }
 
 
+/* Call the dissector function of a handle, whichever type it is. */
+static int
+call_dissector_func(dissector_handle_t handle, tvbuff_t *tvb,
+		    packet_info *pinfo, proto_tree *tree, void *data)
+{
+	int len;
+
+	if (handle->dissector_type == DISSECTOR_TYPE_SIMPLE) {
+		len = ((dissector_t)handle->dissector_func)(tvb, pinfo, tree, data);
+	}
+	else if (handle->dissector_type == DISSECTOR_TYPE_CALLBACK) {
+		len = ((dissector_cb_t)handle->dissector_func)(tvb, pinfo, tree, data, handle->dissector_data);
+	}
+	else {
+		ws_assert_not_reached();
+	}
+	return len;
+}
+
+/*
+ * Get the current time and the bytes allocated so far from the packet and
+ * file scopes. Neither scope is freed while a packet is being dissected, so
+ * the difference between two readings is what was allocated in between.
+ */
+static void
+dissector_profile_usage_get(packet_info *pinfo, dissector_profile_usage_t *usage)
+{
+	wmem_allocator_stats_t stats;
+
+	usage->ns = ws_clock_get_monotonic_ns();
+
+	usage->packet_bytes = 0;
+	if (pinfo->pool != NULL) {
+		wmem_get_stats(pinfo->pool, &stats);
+		usage->packet_bytes = stats.bytes_allocated;
+	}
+	wmem_get_stats(wmem_packet_scope(), &stats);
+	usage->packet_bytes += stats.bytes_allocated;
+
+	wmem_get_stats(wmem_file_scope(), &stats);
+	usage->file_bytes = stats.bytes_allocated;
+}
+
+/*
+ * Call the dissector for a handle, accumulating its call count, the
+ * exceptions it lets through, the time spent in it - both including
+ * and excluding the sub-dissectors it calls - and the memory it
+ * allocates itself in the profile of its protocol.
+ */
+static int
+call_dissector_func_profiled(dissector_handle_t handle, tvbuff_t *tvb,
+			     packet_info *pinfo, proto_tree *tree, void *data)
+{
+	dissector_profile_t       *profile;
+	dissector_profile_usage_t  start, end, used;
+	dissector_profile_usage_t  saved_child;
+	volatile gboolean          threw = FALSE;
+	volatile int               len = 0;
+
+	profile = (dissector_profile_t *)g_hash_table_lookup(dissector_profiles, handle->protocol);
+	if (profile == NULL) {
+		profile = g_new0(dissector_profile_t, 1);
+		profile->proto_name = proto_get_protocol_short_name(handle->protocol);
+		g_hash_table_insert(dissector_profiles, handle->protocol, profile);
+	}
+
+	saved_child = dissector_profile_child;
+	memset(&dissector_profile_child, 0, sizeof(dissector_profile_child));
+	dissector_profile_usage_get(pinfo, &start);
+
+	TRY {
+		len = call_dissector_func(handle, tvb, pinfo, tree, data);
+	}
+	CATCH_ALL {
+		threw = TRUE;
+		RETHROW;
+	}
+	FINALLY {
+		dissector_profile_usage_get(pinfo, &end);
+		used.ns = end.ns - start.ns;
+		used.packet_bytes = end.packet_bytes - start.packet_bytes;
+		used.file_bytes = end.file_bytes - start.file_bytes;
+
+		profile->calls++;
+		if (threw)
+			profile->exceptions++;
+		profile->total_ns += used.ns;
+		profile->self_ns += used.ns - MIN(used.ns, dissector_profile_child.ns);
+		profile->self_packet_bytes += used.packet_bytes - MIN(used.packet_bytes, dissector_profile_child.packet_bytes);
+		profile->self_file_bytes += used.file_bytes - MIN(used.file_bytes, dissector_profile_child.file_bytes);
+
+		dissector_profile_child.ns = saved_child.ns + used.ns;
+		dissector_profile_child.packet_bytes = saved_child.packet_bytes + used.packet_bytes;
+		dissector_profile_child.file_bytes = saved_child.file_bytes + used.file_bytes;
+	}
+	ENDTRY;
+
+	return len;
+}
+
 /* This function will return
  * old style dissector :
  *   length of the payload or 1 of the payload is empty
@@ -815,20 +984,49 @@ call_dissector_through_handle(dissector_handle_t handle, tvbuff_t *tvb,
 			proto_get_protocol_short_name(handle->protocol);
 	}
 
-	if (handle->dissector_type == DISSECTOR_TYPE_SIMPLE) {
-		len = ((dissector_t)handle->dissector_func)(tvb, pinfo, tree, data);
-	}
-	else if (handle->dissector_type == DISSECTOR_TYPE_CALLBACK) {
-		len = ((dissector_cb_t)handle->dissector_func)(tvb, pinfo, tree, data, handle->dissector_data);
+	if (dissector_profiling) {
+		len = call_dissector_func_profiled(handle, tvb, pinfo, tree, data);
 	}
 	else {
-		ws_assert_not_reached();
+		len = call_dissector_func(handle, tvb, pinfo, tree, data);
 	}
 	pinfo->current_proto = saved_proto;
 
 	return len;
 }
 
+void
+dissector_profiling_enable(gboolean enable)
+{
+	dissector_profiling = enable;
+	memset(&dissector_profile_child, 0, sizeof(dissector_profile_child));
+}
+
+gboolean
+dissector_profiling_enabled(void)
+{
+	return dissector_profiling;
+}
+
+void
+dissector_profiling_reset(void)
+{
+	g_hash_table_remove_all(dissector_profiles);
+	memset(&dissector_profile_child, 0, sizeof(dissector_profile_child));
+}
+
+void
+dissector_profiling_foreach(dissector_profile_func func, gpointer user_data)
+{
+	GHashTableIter iter;
+	gpointer       value;
+
+	g_hash_table_iter_init(&iter, dissector_profiles);
+	while (g_hash_table_iter_next(&iter, NULL, &value)) {
+		func((const dissector_profile_t *)value, user_data);
+	}
+}
+
 /*
  * Call a dissector through a handle.
  * If the protocol for that handle isn't enabled, return 0 without
@@ -1063,6 +1261,60 @@ find_dissector_table(const char *name)
 	return dissector_table;
 }
 
+/* Discard the direct index of a uint dissector table, if it has one;
+ * it will be rebuilt once the table has been looked up often enough. */
+static void
+dissector_table_drop_uint_index(dissector_table_t sub_dissectors)
+{
+	g_free(sub_dissectors->uint_index);
+	sub_dissectors->uint_index = NULL;
+	sub_dissectors->uint_lookups = 0;
+}
+
+/* Stop using (and building) a direct index for a uint dissector table. */
+static void
+dissector_table_disable_uint_index(dissector_table_t sub_dissectors)
+{
+	dissector_table_drop_uint_index(sub_dissectors);
+	sub_dissectors->uint_index_size = 0;
+}
+
+static void
+dissector_table_build_uint_index(dissector_table_t sub_dissectors)
+{
+	GHashTableIter iter;
+	gpointer key, value;
+	dtbl_entry_t **uint_index;
+
+	uint_index = g_new0(dtbl_entry_t *, sub_dissectors->uint_index_size);
+	g_hash_table_iter_init(&iter, sub_dissectors->hash_table);
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		if (GPOINTER_TO_UINT(key) >= sub_dissectors->uint_index_size) {
+			/* Somebody registered a value wider than the table type. */
+			g_free(uint_index);
+			dissector_table_disable_uint_index(sub_dissectors);
+			return;
+		}
+		uint_index[GPOINTER_TO_UINT(key)] = (dtbl_entry_t *)value;
+	}
+	sub_dissectors->uint_index = uint_index;
+}
+
+/* Mirror an insertion into, or (with a NULL entry) a removal from, the
+ * hash table of a uint dissector table in its direct index. */
+static void
+dissector_table_update_uint_index(dissector_table_t sub_dissectors, const guint32 pattern, dtbl_entry_t *dtbl_entry)
+{
+	if (sub_dissectors->uint_index == NULL)
+		return;
+
+	if (pattern < sub_dissectors->uint_index_size) {
+		sub_dissectors->uint_index[pattern] = dtbl_entry;
+	} else if (dtbl_entry != NULL) {
+		dissector_table_disable_uint_index(sub_dissectors);
+	}
+}
+
 /* Find an entry in a uint dissector table. */
 static dtbl_entry_t *
 find_uint_dtbl_entry(dissector_table_t sub_dissectors, const guint32 pattern)
@@ -1089,6 +1341,24 @@ find_uint_dtbl_entry(dissector_table_t sub_dissectors, const guint32 pattern)
 		ws_assert_not_reached();
 	}
 
+	/*
+	 * Use the direct index if we have one; it holds every entry
+	 * of the table, so anything out of its range isn't there.
+	 */
+	if (sub_dissectors->uint_index != NULL) {
+		if (pattern >= sub_dissectors->uint_index_size)
+			return NULL;
+		return sub_dissectors->uint_index[pattern];
+	}
+
+	if (sub_dissectors->uint_index_size != 0 &&
+	    ++sub_dissectors->uint_lookups >= DTBL_UINT_INDEX_THRESHOLD) {
+		dissector_table_build_uint_index(sub_dissectors);
+		if (sub_dissectors->uint_index != NULL)
+			return pattern < sub_dissectors->uint_index_size ?
+			    sub_dissectors->uint_index[pattern] : NULL;
+	}
+
 	/*
 	 * Find the entry.
 	 */
@@ -1175,6 +1445,7 @@ dissector_add_uint(const char *name, const guint32 pattern, dissector_handle_t h
 	/* do the table insertion */
 	g_hash_table_insert(sub_dissectors->hash_table,
 			     GUINT_TO_POINTER(pattern), (gpointer)dtbl_entry);
+	dissector_table_update_uint_index(sub_dissectors, pattern, dtbl_entry);
 
 	/*
 	 * Now, if this table supports "Decode As", add this handle
@@ -1336,6 +1607,7 @@ dissector_delete_uint(const char *name, const guint32 pattern,
 		 */
 		g_hash_table_remove(sub_dissectors->hash_table,
 				    GUINT_TO_POINTER(pattern));
+		dissector_table_update_uint_index(sub_dissectors, pattern, NULL);
 	}
 }
 
@@ -1377,6 +1649,7 @@ void dissector_delete_all(const char *name, dissector_handle_t handle)
 	ws_assert (sub_dissectors);
 
 	g_hash_table_foreach_remove (sub_dissectors->hash_table, dissector_delete_all_check, handle);
+	dissector_table_drop_uint_index(sub_dissectors);
 }
 
 static void
@@ -1386,6 +1659,7 @@ dissector_delete_from_table(gpointer key _U_, gpointer value, gpointer user_data
 	ws_assert (sub_dissectors);
 
 	g_hash_table_foreach_remove(sub_dissectors->hash_table, dissector_delete_all_check, user_data);
+	dissector_table_drop_uint_index(sub_dissectors);
 	sub_dissectors->dissector_handles = g_slist_remove(sub_dissectors->dissector_handles, user_data);
 }
 
@@ -1431,6 +1705,7 @@ dissector_change_uint(const char *name, const guint32 pattern, dissector_handle_
 	/* do the table insertion */
 	g_hash_table_insert(sub_dissectors->hash_table,
 			     GUINT_TO_POINTER(pattern), (gpointer)dtbl_entry);
+	dissector_table_update_uint_index(sub_dissectors, pattern, dtbl_entry);
 }
 
 /* Reset an entry in a uint dissector table to its initial value. */
@@ -1459,6 +1734,7 @@ dissector_reset_uint(const char *name, const guint32 pattern)
 	} else {
 		g_hash_table_remove(sub_dissectors->hash_table,
 				    GUINT_TO_POINTER(pattern));
+		dissector_table_update_uint_index(sub_dissectors, pattern, NULL);
 	}
 }
 
@@ -2625,6 +2901,21 @@ register_dissector_table(const char *name, const char *ui_name, const int proto,
 		ws_error("The dissector table %s (%s) is registering an unsupported type - are you using a buggy plugin?", name, ui_name);
 		ws_assert_not_reached();
 	}
+	switch (type) {
+
+	case FT_UINT8:
+		sub_dissectors->uint_index_size = G_MAXUINT8 + 1;
+		break;
+	case FT_UINT16:
+		sub_dissectors->uint_index_size = G_MAXUINT16 + 1;
+		break;
+	default:
+		/* Too sparse for a direct index. */
+		sub_dissectors->uint_index_size = 0;
+		break;
+	}
+	sub_dissectors->uint_index = NULL;
+	sub_dissectors->uint_lookups = 0;
 	sub_dissectors->dissector_handles = NULL;
 	sub_dissectors->ui_name = ui_name;
 	sub_dissectors->type    = type;
@@ -2658,6 +2949,9 @@ dissector_table_t register_custom_dissector_table(const char *name,
 	sub_dissectors->ui_name = ui_name;
 	sub_dissectors->type    = FT_BYTES; /* Consider key a "blob" of data, no need to really create new type */
 	sub_dissectors->param   = BASE_NONE;
+	sub_dissectors->uint_index = NULL;
+	sub_dissectors->uint_index_size = 0;
+	sub_dissectors->uint_lookups = 0;
 	sub_dissectors->protocol  = find_protocol_by_id(proto);
 	sub_dissectors->supports_decode_as = FALSE;
 	g_hash_table_insert(dissector_tables, (gpointer)name, (gpointer) sub_dissectors);
@@ -2815,12 +3109,16 @@ heur_dissector_add(const char *name, heur_dissector_t dissector, const char *dis
 	hdtbl_entry->short_name = g_strdup(internal_name);
 	hdtbl_entry->list_name = g_strdup(name);
 	hdtbl_entry->enabled   = (enable == HEURISTIC_ENABLE);
+	hdtbl_entry->tries     = 0;
+	hdtbl_entry->hits      = 0;
 
 	/* do the table insertion */
 	g_hash_table_insert(heuristic_short_names, (gpointer)hdtbl_entry->short_name, hdtbl_entry);
 
 	sub_dissectors->dissectors = g_slist_prepend(sub_dissectors->dissectors,
 	    (gpointer)hdtbl_entry);
+	sub_dissectors->registered = g_slist_prepend(sub_dissectors->registered,
+	    (gpointer)hdtbl_entry);
 
 	/* XXX - could be optimized to pass hdtbl_entry directly */
 	proto_add_heuristic_dissector(hdtbl_entry->protocol, hdtbl_entry->short_name);
@@ -2864,11 +3162,50 @@ heur_dissector_delete(const char *name, heur_dissector_t dissector, const int pr
 		g_hash_table_remove(heuristic_short_names, found_hdtbl_entry->short_name);
 		proto_add_deregistered_data(found_hdtbl_entry->short_name);
 		proto_add_deregistered_slice(sizeof(heur_dtbl_entry_t), found_hdtbl_entry);
+		sub_dissectors->registered = g_slist_remove(sub_dissectors->registered,
+		    found_hdtbl_entry);
 		sub_dissectors->dissectors = g_slist_delete_link(sub_dissectors->dissectors,
 		    found_entry);
 	}
 }
 
+/*
+ * Move an entry that has just accepted a packet ahead of every entry that
+ * has accepted fewer packets, so that the list stays ordered by success
+ * count and the heuristics that match most often are tried first.  Unlike
+ * moving the entry straight to the top, this doesn't let two busy protocols
+ * keep pushing each other back.
+ *
+ * The entry's predecessor is looked up here rather than remembered by the
+ * caller, as a nested dissector_try_heuristic() on the same list (e.g. by a
+ * tunnelling heuristic) may have reordered it in the meantime.
+ */
+static void
+heur_dissector_promote(heur_dissector_list_t sub_dissectors, GSList *entry)
+{
+	const guint64 hits = ((heur_dtbl_entry_t *)entry->data)->hits;
+	GSList      **link = &sub_dissectors->dissectors;
+	GSList      **prev;
+
+	/* Find where it belongs, i.e. the first entry with fewer hits. */
+	while (*link != NULL && *link != entry &&
+	    ((heur_dtbl_entry_t *)(*link)->data)->hits >= hits) {
+		link = &(*link)->next;
+	}
+	if (*link == NULL || *link == entry)
+		return;
+
+	/* Unlink it from its current position, which is further down. */
+	for (prev = link; *prev != NULL && *prev != entry; prev = &(*prev)->next)
+		;
+	if (*prev == NULL)
+		return;
+	*prev = entry->next;
+
+	entry->next = *link;
+	*link = entry;
+}
+
 gboolean
 dissector_try_heuristic(heur_dissector_list_t sub_dissectors, tvbuff_t *tvb,
 			packet_info *pinfo, proto_tree *tree, heur_dtbl_entry_t **heur_dtbl_entry, void *data)
@@ -2937,6 +3274,7 @@ dissector_try_heuristic(heur_dissector_list_t sub_dissectors, tvbuff_t *tvb,
 
 		pinfo->heur_list_name = hdtbl_entry->list_name;
 
+		hdtbl_entry->tries++;
 		len = (hdtbl_entry->dissector)(tvb, pinfo, tree, data);
 		if (hdtbl_entry->protocol != NULL &&
 			(len == 0 || (tree && saved_tree_count == tree->tree_data->count))) {
@@ -2957,9 +3295,20 @@ dissector_try_heuristic(heur_dissector_list_t sub_dissectors, tvbuff_t *tvb,
 		}
 		if (len) {
 			*heur_dtbl_entry = hdtbl_entry;
+			hdtbl_entry->hits++;
 
-			/* Bubble the matched entry to the top for faster search next time. */
-			if (prev_entry != NULL) {
+			if (prefs.heuristic_learned_order) {
+				/*
+				 * Only learn from the first pass. Revisits
+				 * still see the order learned from later
+				 * packets, not the one this packet saw, so a
+				 * packet that several heuristics accept may
+				 * be dissected differently when revisited.
+				 */
+				if (!PINFO_FD_VISITED(pinfo))
+					heur_dissector_promote(sub_dissectors, entry);
+			} else if (prev_entry != NULL) {
+				/* Bubble the matched entry to the top for faster search next time. */
 				sub_dissectors->dissectors = g_slist_remove_link(sub_dissectors->dissectors, entry);
 				sub_dissectors->dissectors = g_slist_concat(entry, sub_dissectors->dissectors);
 			}
@@ -2975,6 +3324,29 @@ dissector_try_heuristic(heur_dissector_list_t sub_dissectors, tvbuff_t *tvb,
 	return status;
 }
 
+static void
+heur_dissector_reset_stats_func(gpointer data, gpointer user_data _U_)
+{
+	heur_dtbl_entry_t *hdtbl_entry = (heur_dtbl_entry_t *)data;
+
+	hdtbl_entry->tries = 0;
+	hdtbl_entry->hits  = 0;
+}
+
+static void
+heur_dissector_list_reset_stats_func(gpointer key _U_, gpointer value, gpointer user_data _U_)
+{
+	heur_dissector_list_t sub_dissectors = (heur_dissector_list_t)value;
+
+	g_slist_foreach(sub_dissectors->dissectors, heur_dissector_reset_stats_func, NULL);
+}
+
+void
+heur_dissector_reset_stats(void)
+{
+	g_hash_table_foreach(heur_dissector_lists, heur_dissector_list_reset_stats_func, NULL);
+}
+
 typedef struct heur_dissector_foreach_info {
 	gpointer      caller_data;
 	DATFunc_heur  caller_func;
@@ -3069,7 +3441,7 @@ dissector_all_heur_tables_foreach_table (DATFunc_heur_table func,
 	info.caller_func = func;
 	if (compare_key_func != NULL)
 	{
-		list = g_hash_table_get_keys(dissector_tables);
+		list = g_hash_table_get_keys(heur_dissector_lists);
 		list = g_list_sort(list, compare_key_func);
 		g_list_foreach(list, dissector_all_heur_tables_foreach_list_func, &info);
 		g_list_free(list);
@@ -3123,6 +3495,7 @@ register_heur_dissector_list(const char *name, const int proto)
 	sub_dissectors = g_slice_new(struct heur_dissector_list);
 	sub_dissectors->protocol  = find_protocol_by_id(proto);
 	sub_dissectors->dissectors = NULL;	/* initially empty */
+	sub_dissectors->registered = NULL;
 	g_hash_table_insert(heur_dissector_lists, (gpointer)name,
 			    (gpointer) sub_dissectors);
 	return sub_dissectors;
@@ -453,6 +453,8 @@ typedef struct heur_dtbl_entry {
 	const gchar *display_name;     /* the string used to present heuristic to user */
 	gchar *short_name;     /* string used for "internal" use to uniquely identify heuristic */
 	gboolean enabled;
+	guint64 tries;         /* number of times dissector_try_heuristic() called this entry */
+	guint64 hits;          /* number of those calls in which the dissector accepted the packet */
 } heur_dtbl_entry_t;
 
 /** A protocol uses this function to register a heuristic sub-dissector list.
@@ -509,6 +511,11 @@ WS_DLL_PUBLIC gboolean has_heur_dissector_list(const gchar *name);
 WS_DLL_PUBLIC gboolean dissector_try_heuristic(heur_dissector_list_t sub_dissectors,
     tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, heur_dtbl_entry_t **hdtbl_entry, void *data);
 
+/** Reset the try/accept counters of every heuristic dissector in
+ *  every heuristic dissector list.
+ */
+WS_DLL_PUBLIC void heur_dissector_reset_stats(void);
+
 /** Find a heuristic dissector table by table name.
  *
  * @param name name of the dissector table
@@ -628,6 +635,40 @@ WS_DLL_PUBLIC int call_dissector_only(dissector_handle_t handle, tvbuff_t *tvb,
 WS_DLL_PUBLIC void call_heur_dissector_direct(heur_dtbl_entry_t *heur_dtbl_entry, tvbuff_t *tvb,
     packet_info *pinfo, proto_tree *tree, void *data);
 
+/** Dissection profile of one protocol, accumulated over the calls made
+ *  through its dissector handles while dissector profiling is enabled.
+ *  Heuristic dissectors are called without a handle; their time is
+ *  accounted to the protocol that tried them.
+ */
+typedef struct dissector_profile {
+	const char *proto_name; /**< protocol short name, or "(none)" for handles without a protocol */
+	guint64     calls;      /**< number of calls */
+	guint64     exceptions; /**< number of calls that ended with an exception */
+	guint64     total_ns;   /**< time spent in the dissector, including sub-dissectors, in nanoseconds */
+	guint64     self_ns;    /**< time spent in the dissector itself, in nanoseconds */
+	guint64     self_packet_bytes; /**< bytes the dissector itself allocated from pinfo->pool and the packet scope */
+	guint64     self_file_bytes;   /**< bytes the dissector itself allocated from the file scope */
+} dissector_profile_t;
+
+typedef void (*dissector_profile_func)(const dissector_profile_t *profile, gpointer user_data);
+
+/** Turn dissector profiling on or off.  Profiling adds two clock and
+ *  allocator statistics reads and an exception frame to every dissector
+ *  call, so it is off by default.
+ */
+WS_DLL_PUBLIC void dissector_profiling_enable(gboolean enable);
+
+/** Return TRUE if dissector profiling is on. */
+WS_DLL_PUBLIC gboolean dissector_profiling_enabled(void);
+
+/** Discard all accumulated dissector profiles. */
+WS_DLL_PUBLIC void dissector_profiling_reset(void);
+
+/** Call a function for the profile of each protocol dissected since
+ *  profiling was enabled or last reset.  The order is unspecified.
+ */
+WS_DLL_PUBLIC void dissector_profiling_foreach(dissector_profile_func func, gpointer user_data);
+
 /* This is opaque outside of "packet.c". */
 struct depend_dissector_list;
 typedef struct depend_dissector_list *depend_dissector_list_t;
@@ -3723,6 +3723,14 @@ prefs_register_modules(void)
                                    "Currently ICMP and ICMPv6 use this preference to add VLAN ID to conversation tracking, and IPv4 uses this preference to take VLAN ID into account during reassembly",
                                    &prefs.strict_conversation_tracking_heuristics);
 
+    prefs_register_bool_preference(protocols_module, "heuristic_learned_order",
+                                   "Try the most successful heuristic dissectors first",
+                                   "Keep each heuristic dissector list ordered by how many packets its dissectors have accepted, "
+                                   "instead of moving the last match to the front. "
+                                   "A packet that more than one heuristic dissector accepts may be dissected differently "
+                                   "when it is revisited, as the order can change after the first pass.",
+                                   &prefs.heuristic_learned_order);
+
     /* Obsolete preferences
      * These "modules" were reorganized/renamed to correspond to their GUI
      * configuration screen within the preferences dialog
@@ -4233,6 +4241,7 @@ pre_init_prefs(void)
     prefs.st_sort_showfullname = FALSE;
     prefs.display_hidden_proto_items = FALSE;
     prefs.display_byte_fields_with_spaces = FALSE;
+    prefs.heuristic_learned_order = FALSE;
 
     /* set the default values for the io graph dialog */
     prefs.gui_io_graph_automatic_update = TRUE;
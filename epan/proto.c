@@ -911,21 +911,14 @@ proto_registrar_get_nth(guint hfindex)
 /* compute a hash for the part before the dot of a display filter */
 static guint
 prefix_hash (gconstpointer key) {
-	/* end the string at the dot and compute its hash */
-	gchar* copy = g_strdup((const gchar *)key);
-	gchar* c    = copy;
-	guint tmp;
+	/* same as g_str_hash(), but stopping at the dot */
+	const signed char *c = (const signed char *)key;
+	guint32 h = 5381;
 
-	for (; *c; c++) {
-		if (*c == '.') {
-			*c = 0;
-			break;
-		}
-	}
+	for (; *c != '\0' && *c != '.'; c++)
+		h = (h << 5) + h + *c;
 
-	tmp = g_str_hash(copy);
-	g_free(copy);
-	return tmp;
+	return h;
 }
 
 /* are both strings equal up to the end or the dot? */
@@ -969,6 +962,9 @@ initialize_prefix(gpointer k, gpointer v, gpointer u _U_) {
 /** Initialize every remaining uninitialized prefix. */
 void
 proto_initialize_all_prefixes(void) {
+	if (!prefixes)
+		return;
+
 	g_hash_table_foreach_remove(prefixes, initialize_prefix, NULL);
 }
 
@@ -201,6 +201,13 @@ WS_DLL_PUBLIC int stats_tree_manip_node_int(manip_node_mode mode,
                                         gboolean with_children,
                                         gint value);
 
+/* Manipulate a node by the id returned when it was created, without
+ * looking it up by name. Only nodes created as parents have an id. */
+WS_DLL_PUBLIC int stats_tree_manip_node_int_by_id(manip_node_mode mode,
+                                        stats_tree *st,
+                                        int node_id,
+                                        gint value);
+
 WS_DLL_PUBLIC int stats_tree_manip_node_float(manip_node_mode mode,
                                         stats_tree *st,
                                         const gchar *name,
@@ -214,6 +221,12 @@ WS_DLL_PUBLIC int stats_tree_manip_node_float(manip_node_mode mode,
 #define tick_stat_node(st,name,parent_id,with_children)                 \
     (stats_tree_manip_node_int(MN_INCREASE,(st),(name),(parent_id),(with_children),1))
 
+#define increase_stat_node_by_id(st,node_id,value)                      \
+    (stats_tree_manip_node_int_by_id(MN_INCREASE,(st),(node_id),(value)))
+
+#define tick_stat_node_by_id(st,node_id)                                \
+    (stats_tree_manip_node_int_by_id(MN_INCREASE,(st),(node_id),1))
+
 #define set_stat_node(st,name,parent_id,with_children,value)            \
     (stats_tree_manip_node_int(MN_SET,(st),(name),(parent_id),(with_children),value))
 
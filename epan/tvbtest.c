@@ -605,6 +605,42 @@ run_tests(void)
 	tvb_free_chain(tvb_parent);  /* should free all tvb's and associated data */
 }
 
+/* A 16-bit needle whose first byte also appears elsewhere, searched with
+ * and without a maximum length. */
+static void
+test_find_guint16(void)
+{
+	static const guint8 data[] = { 0x0d, 0x00, 0x0d, 0x0d, 0x0a, 0x0d };
+	static const struct {
+		gint offset;
+		gint maxlength;
+		gint expected;
+	} cases[] = {
+		{ 0, -1,  3 },
+		{ 0,  4, -1 },
+		{ 0,  5,  3 },
+		{ 3, -1,  3 },
+		{ 4, -1, -1 },
+		{ 5, -1, -1 },
+	};
+	tvbuff_t *tvb;
+	gint offset;
+	guint i;
+
+	tvb = tvb_new_real_data(data, sizeof data, sizeof data);
+	for (i = 0; i < G_N_ELEMENTS(cases); i++) {
+		offset = tvb_find_guint16(tvb, cases[i].offset, cases[i].maxlength, 0x0d0a);
+		if (offset != cases[i].expected) {
+			printf("Failed tvb_find_guint16 Offset=%d Length=%d "
+					"Found=%d Expected=%d\n",
+					cases[i].offset, cases[i].maxlength,
+					offset, cases[i].expected);
+			failed = TRUE;
+		}
+	}
+	tvb_free(tvb);
+}
+
 /* Note: valgrind can be used to check for tvbuff memory leaks */
 int
 main(void)
@@ -615,6 +651,7 @@ main(void)
 
 	except_init();
 	run_tests();
+	test_find_guint16();
 	except_deinit();
 	exit(failed?1:0);
 }
@@ -2283,7 +2283,7 @@ tvb_find_guint8(tvbuff_t *tvb, const gint offset, const gint maxlength, const gu
 	if (tvb->ops->tvb_find_guint8)
 		return tvb->ops->tvb_find_guint8(tvb, abs_offset, limit, needle);
 
-	return tvb_find_guint8_generic(tvb, offset, limit, needle);
+	return tvb_find_guint8_generic(tvb, abs_offset, limit, needle);
 }
 
 /* Same as tvb_find_guint8() with 16bit needle. */
@@ -2291,39 +2291,46 @@ gint
 tvb_find_guint16(tvbuff_t *tvb, const gint offset, const gint maxlength,
 		 const guint16 needle)
 {
-	const guint8 needle1 = ((needle & 0xFF00) >> 8);
-	const guint8 needle2 = ((needle & 0x00FF) >> 0);
-	gint searched_bytes = 0;
-	gint pos = offset;
-
-	do {
-		gint offset1 =
-			tvb_find_guint8(tvb, pos, maxlength - searched_bytes, needle1);
-		gint offset2 = -1;
-
-		if (offset1 == -1) {
-			return -1;
-		}
+	const guint8  needle1 = ((needle & 0xFF00) >> 8);
+	const guint8  needle2 = ((needle & 0x00FF) >> 0);
+	const guint8 *ptr;
+	const guint8 *end;
+	const guint8 *result;
+	guint	      abs_offset = 0;
+	guint	      limit = 0;
+	int           exception;
 
-		searched_bytes = offset - pos + 1;
+	DISSECTOR_ASSERT(tvb && tvb->initialized);
 
-		if ((maxlength != -1) && (searched_bytes >= maxlength)) {
-			return -1;
-		}
+	exception = compute_offset_and_remaining(tvb, offset, &abs_offset, &limit);
+	if (exception)
+		THROW(exception);
 
-		offset2 = tvb_find_guint8(tvb, offset1 + 1, 1, needle2);
+	/* Only search to end of tvbuff, w/o throwing exception. */
+	if (maxlength >= 0 && limit > (guint) maxlength) {
+		limit = (guint) maxlength;
+	}
 
-		searched_bytes += 1;
+	/* Both bytes of the needle have to fit. */
+	if (limit < 2)
+		return -1;
 
-		if (offset2 != -1) {
-			if ((maxlength != -1) && (searched_bytes > maxlength)) {
-				return -1;
-			}
-			return offset1;
-		}
+	ptr = ensure_contiguous(tvb, abs_offset, limit); /* tvb_get_ptr() */
+	if (!ptr)
+		return -1;
 
-		pos = offset1 + 1;
-	} while (searched_bytes < maxlength);
+	/*
+	 * Let memchr() find each candidate first byte and only look at
+	 * the byte following it; the last byte can't start a match.
+	 */
+	end = ptr + limit - 1;
+	for (result = ptr; result < end; result++) {
+		result = (const guint8 *)memchr(result, needle1, end - result);
+		if (result == NULL)
+			return -1;
+		if (result[1] == needle2)
+			return (gint) ((result - ptr) + abs_offset);
+	}
 
 	return -1;
 }
@@ -4076,13 +4083,13 @@ tvb_find_line_end_unquoted(tvbuff_t *tvb, const gint offset, int len, gint *next
 			/*
 			 * Yes - look only for the terminating quote.
 			 */
-			char_offset = tvb_find_guint8(tvb, cur_offset, len,
-				'"');
+			char_offset = tvb_find_guint8(tvb, cur_offset,
+				eob_offset - cur_offset, '"');
 		} else {
 			/*
 			 * Look either for a CR, an LF, or a '"'.
 			 */
-			char_offset = tvb_ws_mempbrk_pattern_guint8(tvb, cur_offset, len, &pbrk_crlf_dquote, &c);
+			char_offset = tvb_ws_mempbrk_pattern_guint8(tvb, cur_offset, eob_offset - cur_offset, &pbrk_crlf_dquote, &c);
 		}
 		if (char_offset == -1) {
 			/*
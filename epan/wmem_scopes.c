@@ -14,6 +14,7 @@
 #include "wmem_scopes.h"
 
 #include <wsutil/ws_assert.h>
+#include "ws_attributes.h"
 
 /* One of the supposed benefits of wmem over the old emem was going to be that
  * the scoping of the various memory pools would be obvious, since they would
@@ -33,19 +34,72 @@
  * We do, however, use some extra booleans and a mountain of assertions to try
  * and catch anybody accessing the pools out of the correct scope. It's not
  * perfect, but it should stop most of the bad behaviour that emem permitted.
+ *
+ * None of the allocators behind these scopes are thread-safe. Each thread
+ * therefore gets its own packet scope, created the first time the thread
+ * uses it, so several threads can be inside a packet scope at once. The file
+ * scope is still shared and belongs to the thread that called
+ * wmem_init_scopes(). With DEBUG_WMEM_SCOPE_OWNER defined, the assertions
+ * also catch any other thread using the file scope while it is entered,
+ * which would otherwise corrupt the allocator silently. (Outside of the scope
+ * only the pointer is handed out - protocol registration, which may run on a
+ * worker thread, does that to create autoreset maps.) That check calls
+ * g_thread_self() on every scope lookup, so it is left out of normal builds,
+ * assertions or not.
  */
 
-/* TODO: Make these thread-local */
-static wmem_allocator_t *packet_scope = NULL;
+/* The calling thread's packet scope */
+static WS_THREAD_LOCAL wmem_allocator_t *packet_scope = NULL;
 static wmem_allocator_t *file_scope   = NULL;
 static wmem_allocator_t *epan_scope   = NULL;
 
+/* Every thread's packet scope, so that wmem_cleanup_scopes() can free them */
+static GPtrArray *packet_scopes = NULL;
+static GMutex packet_scopes_mutex;
+
+/* define DEBUG_WMEM_SCOPE_OWNER to check which thread uses the file scope */
+/* #define DEBUG_WMEM_SCOPE_OWNER */
+
+#ifdef DEBUG_WMEM_SCOPE_OWNER
+/* The thread that owns the file scope. */
+static GThread *scope_owner = NULL;
+
+#define wmem_assert_scope_owner() \
+    ws_assert(g_thread_self() == scope_owner)
+
+#define wmem_assert_scope_owner_if_in_scope(scope) \
+    ws_assert(!wmem_in_scope(scope) || g_thread_self() == scope_owner)
+#else
+#define wmem_assert_scope_owner()
+#define wmem_assert_scope_owner_if_in_scope(scope)
+#endif
+
 /* Packet Scope */
 
+static void
+wmem_new_packet_scope(void)
+{
+    wmem_allocator_t *scope;
+
+    ws_assert(epan_scope);
+
+    scope = wmem_allocator_new(WMEM_ALLOCATOR_BLOCK_FAST);
+    /* Scopes are initialized to TRUE by default on creation */
+    wmem_leave_scope(scope);
+
+    g_mutex_lock(&packet_scopes_mutex);
+    g_ptr_array_add(packet_scopes, scope);
+    g_mutex_unlock(&packet_scopes_mutex);
+
+    packet_scope = scope;
+}
+
 wmem_allocator_t *
 wmem_packet_scope(void)
 {
-    ws_assert(packet_scope);
+    if (G_UNLIKELY(packet_scope == NULL)) {
+        wmem_new_packet_scope();
+    }
 
     return packet_scope;
 }
@@ -53,7 +107,9 @@ wmem_packet_scope(void)
 void
 wmem_enter_packet_scope(void)
 {
-    ws_assert(packet_scope);
+    if (G_UNLIKELY(packet_scope == NULL)) {
+        wmem_new_packet_scope();
+    }
     ws_assert(wmem_in_scope(file_scope));
     ws_assert(!wmem_in_scope(packet_scope));
 
@@ -75,6 +131,7 @@ wmem_allocator_t *
 wmem_file_scope(void)
 {
     ws_assert(file_scope);
+    wmem_assert_scope_owner_if_in_scope(file_scope);
 
     return file_scope;
 }
@@ -83,6 +140,7 @@ void
 wmem_enter_file_scope(void)
 {
     ws_assert(file_scope);
+    wmem_assert_scope_owner();
     ws_assert(!wmem_in_scope(file_scope));
 
     wmem_enter_scope(file_scope);
@@ -92,14 +150,17 @@ void
 wmem_leave_file_scope(void)
 {
     ws_assert(file_scope);
+    wmem_assert_scope_owner();
     ws_assert(wmem_in_scope(file_scope));
-    ws_assert(!wmem_in_scope(packet_scope));
+    ws_assert(!packet_scope || !wmem_in_scope(packet_scope));
 
     wmem_leave_scope(file_scope);
 
     /* this seems like a good time to do garbage collection */
     wmem_gc(file_scope);
-    wmem_gc(packet_scope);
+    if (packet_scope) {
+        wmem_gc(packet_scope);
+    }
 }
 
 /* Epan Scope */
@@ -123,34 +184,55 @@ wmem_init_scopes(void)
 
     wmem_init();
 
-    packet_scope = wmem_allocator_new(WMEM_ALLOCATOR_BLOCK_FAST);
+    packet_scopes = g_ptr_array_new();
     file_scope   = wmem_allocator_new(WMEM_ALLOCATOR_BLOCK);
     epan_scope   = wmem_allocator_new(WMEM_ALLOCATOR_BLOCK);
 
+#ifdef DEBUG_WMEM_SCOPE_OWNER
+    scope_owner  = g_thread_self();
+#endif
+
     /* Scopes are initialized to TRUE by default on creation */
-    wmem_leave_scope(packet_scope);
     wmem_leave_scope(file_scope);
+
+    wmem_new_packet_scope();
 }
 
+/*
+ * Any other thread that used a packet scope must be done with it; its
+ * scope is freed here along with the calling thread's.
+ */
 void
 wmem_cleanup_scopes(void)
 {
+    guint i;
+
     ws_assert(packet_scope);
     ws_assert(file_scope);
     ws_assert(epan_scope);
 
-    ws_assert(!wmem_in_scope(packet_scope));
     ws_assert(!wmem_in_scope(file_scope));
+    wmem_assert_scope_owner();
+
+    for (i = 0; i < packet_scopes->len; i++) {
+        wmem_allocator_t *scope = (wmem_allocator_t *)g_ptr_array_index(packet_scopes, i);
 
-    wmem_destroy_allocator(packet_scope);
+        ws_assert(!wmem_in_scope(scope));
+        wmem_destroy_allocator(scope);
+    }
+    g_ptr_array_free(packet_scopes, TRUE);
     wmem_destroy_allocator(file_scope);
     wmem_destroy_allocator(epan_scope);
 
     wmem_cleanup();
 
+    packet_scopes = NULL;
     packet_scope = NULL;
     file_scope   = NULL;
     epan_scope   = NULL;
+#ifdef DEBUG_WMEM_SCOPE_OWNER
+    scope_owner  = NULL;
+#endif
 }
 
 /*
@@ -28,8 +28,9 @@ wmem_allocator_t *
 wmem_epan_scope(void);
 
 /**
- * @brief Fetch the current packet scope.
+ * @brief Fetch the calling thread's packet scope.
  *
+ * Each thread has its own packet scope, created on first use.
  * Allocated memory is freed when wmem_leave_packet_scope() is called, which is normally at the end of packet dissection.
  */
 WS_DLL_PUBLIC
@@ -64,6 +64,8 @@ typedef struct bridge_info {
     uint32_t visible_fields;
     uint32_t* field_flags;
     int* field_ids;
+    sinsp_field_extract_t *sinsp_fields; // Reused for each event
+    uint32_t *extract_fld_idxs; // Maps a sinsp_fields offset to an hf offset
 } bridge_info;
 
 typedef struct conv_fld_info {
@@ -181,6 +183,8 @@ configure_plugin(bridge_info* bi, char* config _U_)
         bi->hf_ids = (int*)wmem_alloc(wmem_epan_scope(), bi->visible_fields * sizeof(int));
         bi->field_ids = (int*)wmem_alloc(wmem_epan_scope(), bi->visible_fields * sizeof(int));
         bi->field_flags = (guint32*)wmem_alloc(wmem_epan_scope(), bi->visible_fields * sizeof(guint32));
+        bi->sinsp_fields = (sinsp_field_extract_t*)wmem_alloc(wmem_epan_scope(), bi->visible_fields * sizeof(sinsp_field_extract_t));
+        bi->extract_fld_idxs = (uint32_t*)wmem_alloc(wmem_epan_scope(), bi->visible_fields * sizeof(uint32_t));
 
         if (addr_fields) {
             bi->hf_id_to_addr_id = (int *)wmem_alloc(wmem_epan_scope(), bi->visible_fields * sizeof(int));
@@ -494,10 +498,24 @@ dissect_sinsp_span(tvbuff_t* tvb, packet_info* pinfo, proto_tree* tree, void* da
 
     guint8* payload = (guint8*)tvb_get_ptr(tvb, 0, plen);
 
-    sinsp_field_extract_t *sinsp_fields = (sinsp_field_extract_t*) wmem_alloc(pinfo->pool, sizeof(sinsp_field_extract_t) * bi->visible_fields);
+    /*
+     * Plugins can have hundreds of fields, so only extract the ones we
+     * need: those in a visible tree or referenced by a filter or column,
+     * plus the ones used for the Info column, conversations, and addresses.
+     */
+    uint32_t num_fields = 0;
     for (uint32_t fld_idx = 0; fld_idx < bi->visible_fields; fld_idx++) {
         header_field_info* hfinfo = &(bi->hf[fld_idx].hfinfo);
-        sinsp_field_extract_t *sfe = &sinsp_fields[fld_idx];
+        int addr_fld_idx = bi->hf_id_to_addr_id ? bi->hf_id_to_addr_id[fld_idx] : -1;
+
+        if ((bi->field_flags[fld_idx] & (BFF_INFO|BFF_CONVERSATION)) == 0 && addr_fld_idx < 0
+                && !proto_field_is_referenced(fb_tree, bi->hf_ids[fld_idx])) {
+            continue;
+        }
+
+        sinsp_field_extract_t *sfe = &bi->sinsp_fields[num_fields];
+        bi->extract_fld_idxs[num_fields] = fld_idx;
+        num_fields++;
 
         sfe->field_id = bi->field_ids[fld_idx];
         sfe->field_name = hfinfo->abbrev;
@@ -505,10 +523,11 @@ dissect_sinsp_span(tvbuff_t* tvb, packet_info* pinfo, proto_tree* tree, void* da
     }
 
     // If we have a failure, try to dissect what we can first, then bail out with an error.
-    bool rc = extract_sisnp_source_fields(bi->ssi, pinfo->num, payload, plen, pinfo->pool, sinsp_fields, bi->visible_fields);
+    bool rc = extract_sisnp_source_fields(bi->ssi, pinfo->num, payload, plen, pinfo->pool, bi->sinsp_fields, num_fields);
 
-    for (uint32_t fld_idx = 0; fld_idx < bi->visible_fields; fld_idx++) {
-        sinsp_field_extract_t *sfe = &sinsp_fields[fld_idx];
+    for (uint32_t sf_idx = 0; sf_idx < num_fields; sf_idx++) {
+        sinsp_field_extract_t *sfe = &bi->sinsp_fields[sf_idx];
+        uint32_t fld_idx = bi->extract_fld_idxs[sf_idx];
         header_field_info* hfinfo = &(bi->hf[fld_idx].hfinfo);
         conversation_element_t conv_el = {0};
 
@@ -537,7 +556,7 @@ dissect_sinsp_span(tvbuff_t* tvb, packet_info* pinfo, proto_tree* tree, void* da
                                  PROTO_DATA_CONVINFO_USER_BASE + conv_vals_cnt, cvalptr);
             }
 
-            int addr_fld_idx = bi->hf_id_to_addr_id[fld_idx];
+            int addr_fld_idx = bi->hf_id_to_addr_id ? bi->hf_id_to_addr_id[fld_idx] : -1;
             if (addr_fld_idx >= 0) {
                 ws_in4_addr v4_addr;
                 ws_in6_addr v6_addr;
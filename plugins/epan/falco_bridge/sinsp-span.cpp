@@ -40,6 +40,7 @@ typedef struct sinsp_source_info_t {
     const char *description;
     char *last_error;
     const char *fields;
+    std::vector<ss_plugin_extract_field> extract_fields; // Reused for each event
 } sinsp_source_info_t;
 
 typedef struct sinsp_span_t {
@@ -170,13 +171,19 @@ bool get_sinsp_source_field_info(sinsp_source_info_t *ssi, size_t field_num, sin
 bool extract_sisnp_source_fields(sinsp_source_info_t *ssi, uint32_t evt_num, uint8_t *evt_data, uint32_t evt_datalen, wmem_allocator_t *pool, sinsp_field_extract_t *sinsp_fields, uint32_t sinsp_field_len)
 {
     ss_plugin_event evt = { evt_num, evt_data, evt_datalen, (uint64_t) -1 };
-    std::vector<ss_plugin_extract_field> fields;
+    std::vector<ss_plugin_extract_field> &fields = ssi->extract_fields;
 
+    if (sinsp_field_len == 0) {
+        return true;
+    }
+
+    // Shrinking keeps the capacity, so this rarely allocates.
     fields.resize(sinsp_field_len);
     // We must supply field_id, field, arg, and type.
     for (size_t i = 0; i < sinsp_field_len; i++) {
         fields.at(i).field_id = sinsp_fields[i].field_id;
         fields.at(i).field = sinsp_fields[i].field_name;
+        fields.at(i).res_len = 0;
         if (sinsp_fields[i].type == SFT_STRINGZ) {
             fields.at(i).ftype = FTYPE_STRING;
         } else {
@@ -104,25 +104,33 @@ in a message header
 static wmem_map_t *dcerpc_context_zero;
 
 /*
-    The rrpd_list holds information about all of the APDU Request-Response Pairs seen in the trace.
+    The rrpd_streams tree holds information about all of the APDU Request-Response Pairs seen in the trace.
+    It is indexed by ip_proto:stream_no, and each value is a wmem_list_t of the RRPDs for that stream in the
+    order they were created, so that matching a packet only walks the RRPDs of its own stream.
  */
-static wmem_list_t *rrpd_list = NULL;
+static wmem_tree_t *rrpd_streams = NULL;
 
 /*
-    output_rrpd is a hash of pointers to RRPDs on the rrpd_list.  The index is the frame number.  This hash is
+    rrpd_dns_ids holds the most recent DNS RRPD for each ip_proto:stream_no:session_id:msg_id, as a DNS
+    packet can only match an RRPD with the same identification.
+ */
+static wmem_tree_t *rrpd_dns_ids = NULL;
+
+/*
+    output_rrpd is a hash of pointers to RRPDs in rrpd_streams.  The index is the frame number.  This hash is
     used during Wireshark's second scan.  As each packet is processed, TRANSUM uses the packet's frame number to index into
     this hash to determine if we have RTE data for this particular packet, and if so the write_rte function is called.
  */
 static wmem_map_t *output_rrpd;
 
 /*
-    The temp_rsp_rrpd_list holds RRPDs for APDUs where we have not yet seen the header information and so we can't
+    The temp_rsp_rrpd_tree holds RRPDs for APDUs where we have not yet seen the header information and so we can't
     fully qualify the identification of the RRPD (the identification being ip_proto:stream_no:session_id:msg_id).
     This only occurs when a) we are using one of the decode_based calculations (such as SMB2), and b) when we have
-    TCP Reassembly enabled.  Once we receive a header packet for an APDU we migrate the entry from this array to the
-    main rrpd_list.
+    TCP Reassembly enabled.  Once we receive a header packet for an APDU we migrate the entry from this tree to the
+    main rrpd_streams tree.  There is at most one entry per ip_proto:stream_no.
  */
-static wmem_list_t *temp_rsp_rrpd_list = NULL;  /* Reuse these for speed and efficient memory use - issue a warning if we run out */
+static wmem_tree_t *temp_rsp_rrpd_tree = NULL;
 
 /* Optimisation data - the following is used for various optimisation measures */
 static int highest_tcp_stream_no;
@@ -225,6 +233,43 @@ static void update_output_rrpd(RRPD *in_rrpd)
         wmem_map_insert(output_rrpd, GUINT_TO_POINTER(in_rrpd->rsp_last_frame), in_rrpd);
 }
 
+/* Return the list of RRPDs for the stream of in_rrpd, optionally creating it */
+static wmem_list_t *find_rrpd_stream(RRPD *in_rrpd, gboolean create)
+{
+    guint32 ip_proto = in_rrpd->ip_proto;
+    wmem_list_t *stream;
+    wmem_tree_key_t key[] = {
+        { 1, &ip_proto },
+        { 1, &in_rrpd->stream_no },
+        { 0, NULL }
+    };
+
+    stream = (wmem_list_t*)wmem_tree_lookup32_array(rrpd_streams, key);
+    if (stream == NULL && create)
+    {
+        stream = wmem_list_new(wmem_file_scope());
+        wmem_tree_insert32_array(rrpd_streams, key, stream);
+    }
+
+    return stream;
+}
+
+/* Build the rrpd_dns_ids key for in_rrpd in ids, which must hold 6 values */
+static void build_rrpd_dns_key(RRPD *in_rrpd, guint32 *ids, wmem_tree_key_t *key)
+{
+    ids[0] = in_rrpd->ip_proto;
+    ids[1] = in_rrpd->stream_no;
+    ids[2] = (guint32)(in_rrpd->session_id >> 32);
+    ids[3] = (guint32)in_rrpd->session_id;
+    ids[4] = (guint32)(in_rrpd->msg_id >> 32);
+    ids[5] = (guint32)in_rrpd->msg_id;
+
+    key[0].length = 6;
+    key[0].key = ids;
+    key[1].length = 0;
+    key[1].key = NULL;
+}
+
 /* Return the index of the RRPD that has been appended */
 static RRPD* append_to_rrpd_list(RRPD *in_rrpd)
 {
@@ -232,7 +277,16 @@ static RRPD* append_to_rrpd_list(RRPD *in_rrpd)
 
     update_output_rrpd(next_rrpd);
 
-    wmem_list_append(rrpd_list, next_rrpd);
+    wmem_list_append(find_rrpd_stream(next_rrpd, TRUE), next_rrpd);
+
+    if (next_rrpd->calculation == RTE_CALC_DNS)
+    {
+        guint32 ids[6];
+        wmem_tree_key_t key[2];
+
+        build_rrpd_dns_key(next_rrpd, ids, key);
+        wmem_tree_insert32_array(rrpd_dns_ids, key, next_rrpd);
+    }
 
     return next_rrpd;
 }
@@ -240,9 +294,14 @@ static RRPD* append_to_rrpd_list(RRPD *in_rrpd)
 static RRPD *find_latest_rrpd_dcerpc(RRPD *in_rrpd)
 {
     RRPD *rrpd;
+    wmem_list_t *stream;
     wmem_list_frame_t* i;
 
-    for (i = wmem_list_tail(rrpd_list); i != NULL; i = wmem_list_frame_prev(i))
+    stream = find_rrpd_stream(in_rrpd, FALSE);
+    if (stream == NULL)
+        return NULL;
+
+    for (i = wmem_list_tail(stream); i != NULL; i = wmem_list_frame_prev(i))
     {
         rrpd = (RRPD*)wmem_list_frame_data(i);
 
@@ -278,8 +337,8 @@ static RRPD *find_latest_rrpd_dcerpc(RRPD *in_rrpd)
                 }
                 else  /* The in_rrpd relates to a packet going s2c */
                 {
-                    /* When reassembly is enabled, multi-packet response information is actually migrated from the temp_rsp_rrpd_list
-                    to the rrpd_list and so we won't come through here. */
+                    /* When reassembly is enabled, multi-packet response information is actually migrated from the temp_rsp_rrpd_tree
+                    to rrpd_streams and so we won't come through here. */
                     ;
                 }
             }
@@ -316,42 +375,32 @@ static RRPD *find_latest_rrpd_dcerpc(RRPD *in_rrpd)
 static RRPD *find_latest_rrpd_dns(RRPD *in_rrpd)
 {
     RRPD *rrpd;
-    wmem_list_frame_t* i;
+    guint32 ids[6];
+    wmem_tree_key_t key[2];
 
-    for (i = wmem_list_tail(rrpd_list); i != NULL; i = wmem_list_frame_prev(i))
-    {
-        rrpd = (RRPD*)wmem_list_frame_data(i);
+    build_rrpd_dns_key(in_rrpd, ids, key);
+    rrpd = (RRPD*)wmem_tree_lookup32_array(rrpd_dns_ids, key);
 
-        if (rrpd->calculation != RTE_CALC_DNS)
-            continue;
-
-        /* if the input 5-tuple doesn't match the rrpd_list_entry 5-tuple -> go find the next list entry */
-        if (rrpd->ip_proto == in_rrpd->ip_proto && rrpd->stream_no == in_rrpd->stream_no)
-        {
-            if (rrpd->session_id == in_rrpd->session_id && rrpd->msg_id == in_rrpd->msg_id)
-            {
-                if (in_rrpd->c2s && rrpd->rsp_first_frame)
-                    return NULL;  /* this is new */
-                else
-                    return rrpd;
-            }
-        }  /* this is the end of the 5-tuple check */
+    if (rrpd == NULL)
+        return NULL;
 
-        if (in_rrpd->c2s)
-            in_rrpd->req_search_total++;
-        else
-            in_rrpd->rsp_search_total++;
-    } /* this is the end of the for loop */
+    if (in_rrpd->c2s && rrpd->rsp_first_frame)
+        return NULL;  /* this is new */
 
-    return NULL;
+    return rrpd;
 }
 
 static RRPD *find_latest_rrpd_gtcp(RRPD *in_rrpd)
 {
     RRPD *rrpd;
+    wmem_list_t *stream;
     wmem_list_frame_t* i;
 
-    for (i = wmem_list_tail(rrpd_list); i != NULL; i = wmem_list_frame_prev(i))
+    stream = find_rrpd_stream(in_rrpd, FALSE);
+    if (stream == NULL)
+        return NULL;
+
+    for (i = wmem_list_tail(stream); i != NULL; i = wmem_list_frame_prev(i))
     {
         rrpd = (RRPD*)wmem_list_frame_data(i);
 
@@ -379,9 +428,14 @@ static RRPD *find_latest_rrpd_gtcp(RRPD *in_rrpd)
 static RRPD *find_latest_rrpd_gudp(RRPD *in_rrpd)
 {
     RRPD *rrpd;
+    wmem_list_t *stream;
     wmem_list_frame_t* i;
 
-    for (i = wmem_list_tail(rrpd_list); i != NULL; i = wmem_list_frame_prev(i))
+    stream = find_rrpd_stream(in_rrpd, FALSE);
+    if (stream == NULL)
+        return NULL;
+
+    for (i = wmem_list_tail(stream); i != NULL; i = wmem_list_frame_prev(i))
     {
         rrpd = (RRPD*)wmem_list_frame_data(i);
 
@@ -409,9 +463,14 @@ static RRPD *find_latest_rrpd_gudp(RRPD *in_rrpd)
 static RRPD *find_latest_rrpd_smb2(RRPD *in_rrpd)
 {
     RRPD *rrpd;
+    wmem_list_t *stream;
     wmem_list_frame_t* i;
 
-    for (i = wmem_list_tail(rrpd_list); i != NULL; i = wmem_list_frame_prev(i))
+    stream = find_rrpd_stream(in_rrpd, FALSE);
+    if (stream == NULL)
+        return NULL;
+
+    for (i = wmem_list_tail(stream); i != NULL; i = wmem_list_frame_prev(i))
     {
         rrpd = (RRPD*)wmem_list_frame_data(i);
 
@@ -447,8 +506,8 @@ static RRPD *find_latest_rrpd_smb2(RRPD *in_rrpd)
                 }
                 else  /* The in_rrpd relates to a packet going s2c */
                 {
-                    /* When reassembly is enabled, multi-packet response information is actually migrated from the temp_rsp_rrpd_list
-                    to the rrpd_list and so we won't come through here. */
+                    /* When reassembly is enabled, multi-packet response information is actually migrated from the temp_rsp_rrpd_tree
+                    to rrpd_streams and so we won't come through here. */
                     ;
                 }
             }
@@ -485,9 +544,14 @@ static RRPD *find_latest_rrpd_smb2(RRPD *in_rrpd)
 static RRPD *find_latest_rrpd_syn(RRPD *in_rrpd)
 {
     RRPD *rrpd;
+    wmem_list_t *stream;
     wmem_list_frame_t* i;
 
-    for (i = wmem_list_tail(rrpd_list); i != NULL; i = wmem_list_frame_prev(i))
+    stream = find_rrpd_stream(in_rrpd, FALSE);
+    if (stream == NULL)
+        return NULL;
+
+    for (i = wmem_list_tail(stream); i != NULL; i = wmem_list_frame_prev(i))
     {
         rrpd = (RRPD*)wmem_list_frame_data(i);
 
@@ -604,31 +668,34 @@ static void update_rrpd_list_entry_req(RRPD *in_rrpd)
 }
 
 /*
-    This function inserts an RRPD into the temp_rsp_rrpd_list.  If this is
+    This function inserts an RRPD into the temp_rsp_rrpd_tree.  If this is
     successful return a pointer to the entry, else return NULL.
  */
-static RRPD* insert_into_temp_rsp_rrpd_list(RRPD *in_rrpd)
+static RRPD* insert_into_temp_rsp_rrpd_tree(RRPD *in_rrpd)
 {
     RRPD *rrpd = (RRPD*)wmem_memdup(wmem_file_scope(), in_rrpd, sizeof(RRPD));
+    guint32 ip_proto = rrpd->ip_proto;
+    wmem_tree_key_t key[] = {
+        { 1, &ip_proto },
+        { 1, &rrpd->stream_no },
+        { 0, NULL }
+    };
 
-    wmem_list_append(temp_rsp_rrpd_list, rrpd);
+    wmem_tree_insert32_array(temp_rsp_rrpd_tree, key, rrpd);
 
     return rrpd;
 }
 
 static RRPD* find_temp_rsp_rrpd(RRPD *in_rrpd)
 {
-    wmem_list_frame_t *i;
-    RRPD* rrpd;
-
-    for (i = wmem_list_head(temp_rsp_rrpd_list); i; i = wmem_list_frame_next(i))
-    {
-        rrpd = (RRPD*)wmem_list_frame_data(i);
-        if (rrpd->ip_proto == in_rrpd->ip_proto && rrpd->stream_no == in_rrpd->stream_no)
-            return rrpd;
-    }
+    guint32 ip_proto = in_rrpd->ip_proto;
+    wmem_tree_key_t key[] = {
+        { 1, &ip_proto },
+        { 1, &in_rrpd->stream_no },
+        { 0, NULL }
+    };
 
-    return NULL;
+    return (RRPD*)wmem_tree_lookup32_array(temp_rsp_rrpd_tree, key);
 }
 
 static void update_temp_rsp_rrpd(RRPD *temp_list, RRPD *in_rrpd)
@@ -637,12 +704,20 @@ static void update_temp_rsp_rrpd(RRPD *temp_list, RRPD *in_rrpd)
     temp_list->rsp_last_rtime = in_rrpd->rsp_last_rtime;
 }
 
-/* This function migrates an entry from the temp_rsp_rrpd_list to the main rrpd_list. */
+/* This function migrates an entry from the temp_rsp_rrpd_tree to the main rrpd_streams tree. */
 static void migrate_temp_rsp_rrpd(RRPD *main_list, RRPD *temp_list)
 {
+    guint32 ip_proto = temp_list->ip_proto;
+    wmem_tree_key_t key[] = {
+        { 1, &ip_proto },
+        { 1, &temp_list->stream_no },
+        { 0, NULL }
+    };
+
     update_rrpd_list_entry(main_list, temp_list);
 
-    wmem_list_remove(temp_rsp_rrpd_list, temp_list);
+    /* There is no way to remove a node with an array key, so clear it instead */
+    wmem_tree_insert32_array(temp_rsp_rrpd_tree, key, NULL);
 }
 
 static void update_rrpd_list_entry_rsp(RRPD *in_rrpd)
@@ -662,7 +737,7 @@ static void update_rrpd_list_entry_rsp(RRPD *in_rrpd)
                 {
                     update_temp_rsp_rrpd(temp_list, in_rrpd);
 
-                    /* Migrate the temp_rsp_rrpd_list entry to the main rrpd_list */
+                    /* Migrate the temp_rsp_rrpd_tree entry to rrpd_streams */
                     match = find_latest_rrpd(in_rrpd);
                     if (match != NULL)
                         migrate_temp_rsp_rrpd(match, temp_list);
@@ -670,14 +745,14 @@ static void update_rrpd_list_entry_rsp(RRPD *in_rrpd)
                 else
                 {
                     match = find_latest_rrpd(in_rrpd);
-                    /* There isn't an entry in the temp_rsp_rrpd_list so update the master rrpd_list entry */
+                    /* There isn't an entry in the temp_rsp_rrpd_tree so update the master rrpd_list entry */
                     if (match != NULL)
                         update_rrpd_list_entry(match, in_rrpd);
                 }
             }
             else
             {
-                /* Update an existing entry to the temp_rsp_rrpd_list or add a new one. */
+                /* Update an existing entry in the temp_rsp_rrpd_tree or add a new one. */
                 temp_list = find_temp_rsp_rrpd(in_rrpd);
 
                 if (temp_list != NULL)
@@ -692,11 +767,11 @@ static void update_rrpd_list_entry_rsp(RRPD *in_rrpd)
                         if (match != NULL)
                             update_rrpd_list_entry(match, in_rrpd);
                         else
-                            insert_into_temp_rsp_rrpd_list(in_rrpd);
+                            insert_into_temp_rsp_rrpd_tree(in_rrpd);
                     }
                     else
                         /* As it's not a retransmission, just create a new entry on the temp list */
-                        insert_into_temp_rsp_rrpd_list(in_rrpd);
+                        insert_into_temp_rsp_rrpd_tree(in_rrpd);
                 }
             }
         }
@@ -721,7 +796,7 @@ static void update_rrpd_list_entry_rsp(RRPD *in_rrpd)
 
 
 /*
-    This function updates the RTE data of an RRPD on the rrpd_list.  The
+    This function updates the RTE data of an RRPD in rrpd_streams.  The
     frame_no values in the input RRPD double up as a mask.  If the frame_no
     is > 0 then the frame_no value and rtime values are updated.  If the
     frame_no is 0 then that particular frame_no and rtime value is not updated.
@@ -764,8 +839,9 @@ static void init_globals(void)
     /* Create and initialise some dynamic memory areas */
     tcp_stream_exceptions = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
     detected_tcp_svc = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
-    rrpd_list = wmem_list_new(wmem_file_scope());
-    temp_rsp_rrpd_list = wmem_list_new(wmem_file_scope());
+    rrpd_streams = wmem_tree_new(wmem_file_scope());
+    rrpd_dns_ids = wmem_tree_new(wmem_file_scope());
+    temp_rsp_rrpd_tree = wmem_tree_new(wmem_file_scope());
 
     /* Indicate what fields we're interested in. */
     GArray *wanted_fields = g_array_sized_new(FALSE, FALSE, (guint)sizeof(int), HF_INTEREST_END_OF_LIST);
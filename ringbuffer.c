@@ -84,10 +84,23 @@ typedef struct _ringbuf_data {
 
     GMutex        mutex;               /**< mutex for oldnames */
     gchar        *oldnames[MAX_FILENAME_QUEUE];       /**< filename list of pending to be deleted */
+
+    GThreadPool  *workers;             /**< removes and compresses finished files */
 } ringbuf_data;
 
 static ringbuf_data rb_data;
 
+/* Work handed to the worker pool when a file is finished */
+typedef enum {
+    RB_TASK_UNLINK,                    /**< remove a file that left the ring */
+    RB_TASK_COMPRESS                   /**< compress a finished file */
+} rb_task_type;
+
+typedef struct _rb_task {
+    rb_task_type  type;
+    gchar        *name;
+} rb_task;
+
 /*
  * delete pending uncompressed pcap files.
  */
@@ -185,27 +198,59 @@ ringbuf_exec_compress(gchar* name)
     return 0;
 }
 
+#endif
+
 /*
- * thread to compress capture file
+ * run a task on a worker thread
  */
-static void*
-exec_compress_thread(void* arg)
+static void
+ringbuf_exec_task(gpointer data, gpointer user_data _U_)
 {
-    ringbuf_exec_compress((gchar*)arg);
-    return NULL;
+    rb_task *task = (rb_task *)data;
+
+    switch (task->type) {
+
+    case RB_TASK_UNLINK:
+        /* remove old file (if any, so ignore error) */
+        ws_unlink(task->name);
+        g_free(task->name);
+        break;
+
+#ifdef HAVE_ZLIB
+    case RB_TASK_COMPRESS:
+        /* takes ownership of the name */
+        ringbuf_exec_compress(task->name);
+        break;
+#endif
+
+    default:
+        g_free(task->name);
+        break;
+    }
+    g_free(task);
 }
 
 /*
- * start a thread to compress capture file
+ * queue work on a finished file, so that removing or compressing a large
+ * file doesn't hold up the capture at a file switch; takes ownership of
+ * the name
  */
-static int
-ringbuf_start_compress_file(rb_file* rfile)
+static void
+ringbuf_start_task(rb_task_type type, gchar *name)
 {
-    gchar* name = g_strdup(rfile->name);
-    g_thread_new("exec_compress", &exec_compress_thread, name);
-    return 0;
+    rb_task *task;
+
+    if (rb_data.workers == NULL) {
+        /* not exclusive, so this can't fail */
+        rb_data.workers = g_thread_pool_new(ringbuf_exec_task, NULL,
+                g_get_num_processors(), FALSE, NULL);
+    }
+
+    task = g_new(rb_task, 1);
+    task->type = type;
+    task->name = name;
+    g_thread_pool_push(rb_data.workers, task, NULL);
 }
-#endif
 
 /*
  * create the next filename and open a new binary file with that name
@@ -217,19 +262,7 @@ ringbuf_open_file(rb_file *rfile, int *err)
     char    timestr[14+1];
     time_t  current_time;
     struct tm *tm;
-
-    if (rfile->name != NULL) {
-        if (rb_data.unlimited == FALSE) {
-            /* remove old file (if any, so ignore error) */
-            ws_unlink(rfile->name);
-        }
-#ifdef HAVE_ZLIB
-        else if (rb_data.compress_type != NULL && strcmp(rb_data.compress_type, "gzip") == 0) {
-            ringbuf_start_compress_file(rfile);
-        }
-#endif
-        g_free(rfile->name);
-    }
+    gchar   *old_name = rfile->name;
 
 #ifdef _WIN32
     _tzset();
@@ -248,6 +281,26 @@ ringbuf_open_file(rb_file *rfile, int *err)
         rfile->name = g_strconcat(rb_data.fprefix, "_", filenum, "_", timestr, rb_data.fsuffix, NULL);
     }
 
+    if (old_name != NULL) {
+        if (rb_data.unlimited == FALSE) {
+            if (strcmp(old_name, rfile->name) == 0) {
+                /* we're about to reuse the name; it must be gone first */
+                ws_unlink(old_name);
+                g_free(old_name);
+            } else {
+                ringbuf_start_task(RB_TASK_UNLINK, old_name);
+            }
+        }
+#ifdef HAVE_ZLIB
+        else if (rb_data.compress_type != NULL && strcmp(rb_data.compress_type, "gzip") == 0) {
+            ringbuf_start_task(RB_TASK_COMPRESS, old_name);
+        }
+#endif
+        else {
+            g_free(old_name);
+        }
+    }
+
     if (rfile->name == NULL) {
         if (err != NULL)
             *err = ENOMEM;
@@ -287,6 +340,7 @@ ringbuf_init(const char *capfile_name, guint num_files, gboolean group_read_acce
     rb_data.group_read_access = group_read_access;
     rb_data.name_h = NULL;
     rb_data.compress_type = compress_type;
+    rb_data.workers = NULL;
     g_mutex_init(&rb_data.mutex);
 
     /* just to be sure ... */
@@ -531,6 +585,12 @@ ringbuf_free(void)
 {
     unsigned int i;
 
+    /* let queued removals and compressions finish */
+    if (rb_data.workers != NULL) {
+        g_thread_pool_free(rb_data.workers, FALSE, TRUE);
+        rb_data.workers = NULL;
+    }
+
     if (rb_data.files != NULL) {
         for (i=0; i < rb_data.num_files; i++) {
             if (rb_data.files[i].name != NULL) {
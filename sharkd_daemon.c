@@ -386,7 +386,7 @@ sharkd_loop(int argc _U_, char* argv[])
             continue;
         }
 
-        /* wireshark is not ready for handling multiple capture files in single process, so fork(), and handle it in separate process */
+        /* wireshark is not ready for handling multiple capture files in single process (epan_new() allows only one live session), so fork(), and handle it in separate process */
 #ifndef _WIN32
         pid = fork();
         if (pid == 0)
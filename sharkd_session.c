@@ -26,6 +26,7 @@
 
 #include <file.h>
 #include <epan/epan_dissect.h>
+#include <epan/packet.h>
 #include <epan/exceptions.h>
 #include <epan/color_filters.h>
 #include <epan/prefs.h>
@@ -67,6 +68,7 @@
 #endif /* HAVE_SPEEXDSP */
 
 #include <epan/maxmind_db.h>
+#include <epan/app_mem_usage.h>
 
 #include <wsutil/pint.h>
 #include <wsutil/strtoi.h>
@@ -366,6 +368,7 @@ json_prep(char* buf, const jsmntok_t* tokens, int count)
         {"method",     "bye",        1, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"method",     "check",      1, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"method",     "complete",   1, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
+        {"method",     "dissectorprof", 1, JSMN_STRING,    SHARKD_JSON_STRING,   OPTIONAL},
         {"method",     "download",   1, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"method",     "dumpconf",   1, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"method",     "follow",     1, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
@@ -385,6 +388,7 @@ json_prep(char* buf, const jsmntok_t* tokens, int count)
         {"check",      "filter",     2, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"complete",   "field",      2, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"complete",   "pref",       2, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
+        {"dissectorprof", "enable",  2, JSMN_PRIMITIVE,    SHARKD_JSON_BOOLEAN,  OPTIONAL},
         {"download",   "token",      2, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"dumpconf",   "pref",       2, JSMN_STRING,       SHARKD_JSON_STRING,   OPTIONAL},
         {"follow",     "follow",     2, JSMN_STRING,       SHARKD_JSON_STRING,   MANDATORY},
@@ -1093,6 +1097,20 @@ sharkd_session_process_load(const char *buf, const jsmntok_t *tokens, int count)
         sharkd_json_simple_ok(rpcid);
 }
 
+static void
+sharkd_session_process_status_wmem(const char *name, wmem_allocator_t *scope)
+{
+    wmem_allocator_stats_t stats;
+
+    wmem_get_stats(scope, &stats);
+    json_dumper_begin_object(&dumper);
+    sharkd_json_value_string("name", name);
+    sharkd_json_value_anyf("allocs", "%" PRIu64, stats.allocs);
+    sharkd_json_value_anyf("bytes_allocated", "%" PRIu64, stats.bytes_allocated);
+    sharkd_json_value_anyf("peak_bytes_allocated", "%" PRIu64, stats.peak_bytes_allocated);
+    json_dumper_end_object(&dumper);
+}
+
 /**
  * sharkd_session_process_status()
  *
@@ -1103,10 +1121,22 @@ sharkd_session_process_load(const char *buf, const jsmntok_t *tokens, int count)
  *   (m) duration - time difference between time of first frame, and last loaded frame
  *   (o) filename - capture filename
  *   (o) filesize - capture filesize
+ *   (m) memory   - array of objects with attributes:
+ *                  'name'  - process memory component, e.g. "Total" or "RSS"
+ *                  'bytes' - bytes used by the component
+ *   (m) wmem     - array of objects with attributes:
+ *                  'name'                 - wmem scope, "file" or "epan"
+ *                  'allocs'               - allocations since the scope was last freed
+ *                  'bytes_allocated'      - bytes requested since then; frees are not subtracted
+ *                  'peak_bytes_allocated' - largest bytes_allocated seen
  */
 static void
 sharkd_session_process_status(void)
 {
+    const char *mem_name;
+    gsize mem_value;
+    guint i;
+
     sharkd_json_result_prologue(rpcid);
 
     sharkd_json_value_anyf("frames", "%u", cfile.count);
@@ -1128,6 +1158,82 @@ sharkd_session_process_status(void)
             sharkd_json_value_anyf("filesize", "%" PRId64, file_size);
     }
 
+    sharkd_json_array_open("memory");
+    for (i = 0; (mem_name = memory_usage_get(i, &mem_value)) != NULL; i++)
+    {
+        json_dumper_begin_object(&dumper);
+        sharkd_json_value_string("name", mem_name);
+        sharkd_json_value_anyf("bytes", "%" G_GSIZE_FORMAT, mem_value);
+        json_dumper_end_object(&dumper);
+    }
+    sharkd_json_array_close();
+
+    sharkd_json_array_open("wmem");
+    sharkd_session_process_status_wmem("file", wmem_file_scope());
+    sharkd_session_process_status_wmem("epan", wmem_epan_scope());
+    sharkd_json_array_close();
+
+    sharkd_json_result_epilogue();
+}
+
+static void
+sharkd_session_process_dissectorprof_cb(const dissector_profile_t *profile, gpointer user_data _U_)
+{
+    json_dumper_begin_object(&dumper);
+    sharkd_json_value_string("proto", profile->proto_name);
+    sharkd_json_value_anyf("calls", "%" PRIu64, profile->calls);
+    sharkd_json_value_anyf("exceptions", "%" PRIu64, profile->exceptions);
+    sharkd_json_value_anyf("total", "%.9f", profile->total_ns / 1e9);
+    sharkd_json_value_anyf("self", "%.9f", profile->self_ns / 1e9);
+    sharkd_json_value_anyf("packet_bytes", "%" PRIu64, profile->self_packet_bytes);
+    sharkd_json_value_anyf("file_bytes", "%" PRIu64, profile->self_file_bytes);
+    json_dumper_end_object(&dumper);
+}
+
+/**
+ * sharkd_session_process_dissectorprof()
+ *
+ * Process dissectorprof request
+ *
+ * Input:
+ *   (o) enable - true to reset the profiles and start profiling the dissectors,
+ *                false to stop profiling
+ *
+ * Output object with attributes (when enable is not given):
+ *   (m) enabled   - whether profiling is on
+ *   (m) protocols - array of objects with attributes:
+ *                  'proto'      - protocol short name
+ *                  'calls'      - number of calls to the protocol's dissector
+ *                  'exceptions' - number of calls that ended with an exception
+ *                  'total'      - seconds spent in the dissector, including sub-dissectors
+ *                  'self'       - seconds spent in the dissector itself
+ *                  'packet_bytes' - bytes the dissector itself allocated from packet scope
+ *                  'file_bytes' - bytes the dissector itself allocated from file scope
+ *
+ * Profiles are collected while frames are dissected, e.g. during "load",
+ * "frames" with a filter, "frame" or "tap".
+ */
+static void
+sharkd_session_process_dissectorprof(char *buf, const jsmntok_t *tokens, int count)
+{
+    const char *tok_enable = json_find_attr(buf, tokens, count, "enable");
+
+    if (tok_enable)
+    {
+        gboolean enable = !strcmp(tok_enable, "true");
+
+        if (enable)
+            dissector_profiling_reset();
+        dissector_profiling_enable(enable);
+        sharkd_json_simple_ok(rpcid);
+        return;
+    }
+
+    sharkd_json_result_prologue(rpcid);
+    sharkd_json_value_anyf("enabled", dissector_profiling_enabled() ? "true" : "false");
+    sharkd_json_array_open("protocols");
+    dissector_profiling_foreach(sharkd_session_process_dissectorprof_cb, NULL);
+    sharkd_json_array_close();
     sharkd_json_result_epilogue();
 }
 
@@ -4985,6 +5091,8 @@ sharkd_session_process(char *buf, const jsmntok_t *tokens, int count)
             sharkd_session_process_check(buf, tokens, count);
         else if (!strcmp(tok_method, "complete"))
             sharkd_session_process_complete(buf, tokens, count);
+        else if (!strcmp(tok_method, "dissectorprof"))
+            sharkd_session_process_dissectorprof(buf, tokens, count);
         else if (!strcmp(tok_method, "frames"))
             sharkd_session_process_frames(buf, tokens, count);
         else if (!strcmp(tok_method, "tap"))
@@ -288,6 +288,50 @@ class case_tshark_z_expert(subprocesstest.SubprocessTestCase):
         self.assertFalse(self.grepOutput('Chats'))
 
 
+@fixtures.mark_usefixtures('test_env')
+@fixtures.uses_fixtures
+class case_tshark_conversation_idle_timeout(subprocesstest.SubprocessTestCase):
+    def test_tshark_conversation_idle_timeout(self, cmd_tshark, capture_file):
+        # communityid.pcap.gz spans 139 seconds and no conversation in it is
+        # idle for more than 35 seconds, so conversations that have ended are
+        # expired without changing the dissection of the ones still active.
+        pcap_file = capture_file('communityid.pcap.gz')
+        baseline = self.assertRun((cmd_tshark, '-V', '-r', pcap_file))
+        expiring = self.assertRun((cmd_tshark, '-V', '-r', pcap_file,
+            '--conversation-idle-timeout', '40'))
+        self.assertEqual(baseline.stdout_str, expiring.stdout_str)
+
+    def test_tshark_conversation_idle_timeout_resumed(self, cmd_tshark, cmd_editcap, cmd_mergecap, capture_file):
+        # Hold back the response of the HTTP connection in communityid.pcap.gz
+        # (frames 90-101) for a minute while the ICMP traffic from the start
+        # of the file keeps arriving, so that the connection goes idle and is
+        # expired before the response shows up.
+        pcap_file = capture_file('communityid.pcap.gz')
+        request_file = self.filename_from_id('request.pcapng')
+        response_file = self.filename_from_id('response.pcapng')
+        other_file = self.filename_from_id('other.pcapng')
+        merged_file = self.filename_from_id('merged.pcapng')
+        self.assertRun((cmd_editcap, '-r', pcap_file, request_file, '90-94'))
+        self.assertRun((cmd_editcap, '-r', '-t', '60', pcap_file, response_file, '95-101'))
+        self.assertRun((cmd_editcap, '-r', '-t', '100', pcap_file, other_file, '1-67'))
+        self.assertRun((cmd_mergecap, '-w', merged_file, request_file, response_file, other_file))
+
+        fields = ('-Y', 'http', '-Tfields', '-etcp.stream', '-ehttp.request.method', '-ehttp.response.code')
+        baseline = self.assertRun((cmd_tshark, '-r', merged_file) + fields)
+        self.assertEqual(baseline.stdout_str.splitlines(), ['0\tGET\t', '0\t\t200'])
+
+        # The resumed connection is dissected as a new TCP stream.
+        expiring = self.assertRun((cmd_tshark, '-r', merged_file,
+            '--conversation-idle-timeout', '20', '--log-level=info') + fields)
+        self.assertEqual(expiring.stdout_str.splitlines(), ['0\tGET\t', '1\t\t200'])
+        self.assertTrue(self.grepOutput(r'expired [1-9][0-9]* idle conversations', proc=expiring))
+
+    def test_tshark_conversation_idle_timeout_two_pass(self, cmd_tshark, capture_file):
+        self.assertRun((cmd_tshark, '-2', '-r', capture_file('communityid.pcap.gz'),
+            '--conversation-idle-timeout', '40'),
+            expected_return=self.exit_command_line)
+
+
 @fixtures.mark_usefixtures('test_env')
 @fixtures.uses_fixtures
 class case_tshark_extcap(subprocesstest.SubprocessTestCase):
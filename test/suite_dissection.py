@@ -370,6 +370,18 @@ class case_dissect_http(subprocesstest.SubprocessTestCase):
             ))
         self.assertTrue(self.grepOutput('This is a test file for testing brotli decompression in Wireshark'))
 
+    def test_http_stats_tree_other(self, cmd_tshark, capture_file):
+        '''HTTP packet counter with continuation data counted as "Other"'''
+        # Without reassembly the request bodies are dissected as
+        # continuations, which are neither requests nor responses.
+        self.assertRun((cmd_tshark,
+                '-r', capture_file('http-ooo.pcap'),
+                '-otcp.desegment_tcp_streams:FALSE',
+                '-q', '-z', 'http,tree',
+            ))
+        self.assertTrue(self.grepOutput(r'HTTP Request Packets\s+[1-9]'))
+        self.assertTrue(self.grepOutput(r'Other HTTP Packets\s+[1-9]'))
+
 @fixtures.mark_usefixtures('test_env')
 @fixtures.uses_fixtures
 class case_dissect_http2(subprocesstest.SubprocessTestCase):
@@ -84,3 +84,31 @@ class case_rawshark_io(subprocesstest.SubprocessTestCase):
         rawshark_cmd = '{0} | "{1}" -r - -n -dencap:1 -R "udp.port==68"'.format(raw_dhcp_cmd, cmd_rawshark)
         rawshark_proc = self.assertRun(rawshark_cmd, shell=True)
         self.assertTrue(self.diffOutput(rawshark_proc.stdout_str, io_baseline_str, 'rawshark', baseline_file))
+
+
+@fixtures.mark_usefixtures('test_env')
+@fixtures.uses_fixtures
+class case_editcap_io(subprocesstest.SubprocessTestCase):
+    def test_editcap_io_zstd_round_trip(self, cmd_editcap, cmd_tshark, capture_file, features):
+        '''Write a zstd compressed file using Editcap and read it back'''
+        if not features.have_zstd:
+            self.skipTest('Requires Zstandard.')
+        testout_file = self.filename_from_id('testout.pcapng.zst')
+        self.assertRun((cmd_editcap,
+            '--compress', 'zstd',
+            capture_file('dhcp.pcap'), testout_file,
+        ))
+        with open(testout_file, 'rb') as f:
+            self.assertEqual(f.read(4), b'\x28\xb5\x2f\xfd')
+        # The summary lines and packet bytes don't depend on the file format.
+        original_proc = self.assertRun((cmd_tshark, '-x', '-r', capture_file('dhcp.pcap')))
+        compressed_proc = self.assertRun((cmd_tshark, '-x', '-r', testout_file))
+        self.assertEqual(original_proc.stdout_str, compressed_proc.stdout_str)
+
+    def test_editcap_io_compress_invalid(self, cmd_editcap, capture_file):
+        '''Reject a compression type Editcap can't write'''
+        testout_file = self.filename_from_id(testout_pcap)
+        self.assertRun((cmd_editcap,
+            '--compress', 'bogus',
+            capture_file('dhcp.pcap'), testout_file,
+        ), expected_return=self.exit_command_line)
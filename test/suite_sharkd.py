@@ -74,7 +74,10 @@ class case_sharkd(subprocesstest.SubprocessTestCase):
         check_sharkd_session((
             {"jsonrpc":"2.0", "id":1, "method":"status"},
         ), (
-            {"jsonrpc":"2.0","id":1,"result":{"frames":0,"duration":0.000000000}},
+            {"jsonrpc":"2.0","id":1,"result":{"frames":0,"duration":0.000000000,
+                "memory": MatchList({"name": MatchAny(str), "bytes": MatchAny(int)}),
+                "wmem": MatchList({"name": MatchAny(str), "allocs": MatchAny(int),
+                    "bytes_allocated": MatchAny(int), "peak_bytes_allocated": MatchAny(int)}, n=2)}},
         ))
 
     def test_sharkd_req_status(self, check_sharkd_session, capture_file):
@@ -86,7 +89,10 @@ class case_sharkd(subprocesstest.SubprocessTestCase):
         ), (
             {"jsonrpc":"2.0","id":1,"result":{"status":"OK"}},
             {"jsonrpc":"2.0","id":2,"result":{"frames": 4, "duration": 0.070345000,
-                "filename": "dhcp.pcap", "filesize": 1400}},
+                "filename": "dhcp.pcap", "filesize": 1400,
+                "memory": MatchList({"name": MatchAny(str), "bytes": MatchAny(int)}),
+                "wmem": MatchList({"name": MatchAny(str), "allocs": MatchAny(int),
+                    "bytes_allocated": MatchAny(int), "peak_bytes_allocated": MatchAny(int)}, n=2)}},
         ))
 
     def test_sharkd_req_analyse(self, check_sharkd_session, capture_file):
@@ -164,6 +170,25 @@ class case_sharkd(subprocesstest.SubprocessTestCase):
             {"jsonrpc":"2.0","id":2,"result":{"pref": []}},
         ))
 
+    def test_sharkd_req_dissectorprof(self, check_sharkd_session, capture_file):
+        check_sharkd_session((
+            {"jsonrpc":"2.0", "id":1, "method":"dissectorprof", "params":{"enable": True}},
+            {"jsonrpc":"2.0", "id":2, "method":"load",
+            "params":{"file": capture_file('dhcp.pcap')}
+            },
+            {"jsonrpc":"2.0", "id":3, "method":"dissectorprof"},
+            {"jsonrpc":"2.0", "id":4, "method":"dissectorprof", "params":{"enable": False}},
+        ), (
+            {"jsonrpc":"2.0","id":1,"result":{"status":"OK"}},
+            {"jsonrpc":"2.0","id":2,"result":{"status":"OK"}},
+            {"jsonrpc":"2.0","id":3,"result":{"enabled": True, "protocols": MatchList(
+                {"proto": "dhcp", "calls": 4, "exceptions": 0,
+                 "total": MatchAny(float), "self": MatchAny(float),
+                 "packet_bytes": MatchAny(int), "file_bytes": MatchAny(int)}, match_element=any)}
+            },
+            {"jsonrpc":"2.0","id":4,"result":{"status":"OK"}},
+        ))
+
     def test_sharkd_req_frames(self, check_sharkd_session, capture_file):
         # XXX need test for optional input parameters, ignored/marked/commented
         check_sharkd_session((
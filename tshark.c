@@ -88,6 +88,7 @@
 #include <epan/epan_dissect.h>
 #include <epan/tap.h>
 #include <epan/stat_tap_ui.h>
+#include <epan/conversation.h>
 #include <epan/conversation_table.h>
 #include <epan/srt_table.h>
 #include <epan/rtd_table.h>
@@ -138,6 +139,7 @@
 #define LONGOPT_CAPTURE_COMMENT         LONGOPT_BASE_APPLICATION+6
 #define LONGOPT_HEXDUMP                 LONGOPT_BASE_APPLICATION+7
 #define LONGOPT_SELECTED_FRAME          LONGOPT_BASE_APPLICATION+8
+#define LONGOPT_CONVERSATION_IDLE_TIMEOUT LONGOPT_BASE_APPLICATION+9
 
 capture_file cfile;
 
@@ -150,6 +152,21 @@ static gboolean perform_two_pass_analysis;
 static guint32 epan_auto_reset_count = 0;
 static gboolean epan_auto_reset = FALSE;
 
+/*
+ * Conversations idle for longer than this many seconds are expired in
+ * single-pass mode; 0 disables expiry. To find them, the frame count is
+ * sampled every conversation_idle_interval seconds of packet time.
+ */
+static guint32 conversation_idle_timeout = 0;
+static guint32 conversation_idle_interval;
+
+typedef struct {
+    nstime_t ts;        /* packet time of the sample */
+    guint32 count;      /* frames processed before that packet */
+} conversation_idle_mark_t;
+
+static GQueue conversation_idle_marks = G_QUEUE_INIT;
+
 static guint32 selected_frame_number = 0;
 
 /*
@@ -242,6 +259,7 @@ static void report_counts_siginfo(int);
 #endif /* HAVE_LIBPCAP */
 
 static void reset_epan_mem(capture_file *cf, epan_dissect_t *edt, gboolean tree, gboolean visual);
+static void expire_idle_conversations(capture_file *cf, const wtap_rec *rec);
 
 typedef enum {
     PROCESS_FILE_SUCCEEDED,
@@ -401,6 +419,9 @@ print_usage(FILE *output)
     fprintf(output, "Processing:\n");
     fprintf(output, "  -2                       perform a two-pass analysis\n");
     fprintf(output, "  -M <packet count>        perform session auto reset\n");
+    fprintf(output, "  --conversation-idle-timeout <seconds>\n");
+    fprintf(output, "                           expire conversations idle for longer than this\n");
+    fprintf(output, "                           (not with -2)\n");
     fprintf(output, "  -R <read filter>, --read-filter <read filter>\n");
     fprintf(output, "                           packet Read filter in Wireshark display filter syntax\n");
     fprintf(output, "                           (requires -2)\n");
@@ -788,6 +809,7 @@ main(int argc, char *argv[])
         {"capture-comment", ws_required_argument, NULL, LONGOPT_CAPTURE_COMMENT},
         {"hexdump", ws_required_argument, NULL, LONGOPT_HEXDUMP},
         {"selected-frame", ws_required_argument, NULL, LONGOPT_SELECTED_FRAME},
+        {"conversation-idle-timeout", ws_required_argument, NULL, LONGOPT_CONVERSATION_IDLE_TIMEOUT},
         {0, 0, 0, 0}
     };
     gboolean             arg_error = FALSE;
@@ -1153,6 +1175,10 @@ main(int argc, char *argv[])
                     cmdarg_err("-2 does not support auto session reset.");
                     arg_error=TRUE;
                 }
+                if(conversation_idle_timeout){
+                    cmdarg_err("-2 does not support conversation expiry.");
+                    arg_error=TRUE;
+                }
                 perform_two_pass_analysis = TRUE;
                 break;
             case 'M':
@@ -1594,6 +1620,14 @@ main(int argc, char *argv[])
                     goto clean_exit;
                 }
                 break;
+            case LONGOPT_CONVERSATION_IDLE_TIMEOUT:
+                if(perform_two_pass_analysis){
+                    cmdarg_err("--conversation-idle-timeout does not support two pass analysis.");
+                    arg_error=TRUE;
+                }
+                conversation_idle_timeout = get_positive_int(ws_optarg, "conversation idle timeout");
+                conversation_idle_interval = MAX(conversation_idle_timeout / 4, 1);
+                break;
             case LONGOPT_SELECTED_FRAME:
                 /* Hidden option to mark a frame as "selected". Used for testing and debugging.
                  * Only active in two-pass mode. */
@@ -2940,6 +2974,7 @@ capture_input_new_packets(capture_session *cap_session, int to_read)
                 wtap_close(cf->provider.wth);
                 cf->provider.wth = NULL;
             } else {
+                expire_idle_conversations(cf, &rec);
                 ret = process_packet_single_pass(cf, edt, data_offset, &rec, &buf,
                         tap_flags);
             }
@@ -3652,6 +3687,7 @@ process_cap_file_single_pass(capture_file *cf, wtap_dumper *pdh,
         ws_debug("tshark: processing packet #%d", framenum);
 
         reset_epan_mem(cf, edt, create_proto_tree, print_packet_info && print_details);
+        expire_idle_conversations(cf, &rec);
 
         if (process_packet_single_pass(cf, edt, data_offset, &rec, &buf, tap_flags)) {
             /* Either there's no read filtering or this packet passed the
@@ -4716,4 +4752,48 @@ reset_epan_mem(capture_file *cf,epan_dissect_t *edt, gboolean tree, gboolean vis
     cf->epan = tshark_epan_new(cf);
     epan_dissect_init(edt, cf->epan, tree, visual);
     cf->count = 0;
+
+    /* The new session starts with no conversations and frame 1. */
+    while (!g_queue_is_empty(&conversation_idle_marks))
+        g_free(g_queue_pop_head(&conversation_idle_marks));
+}
+
+/*
+ * Drop the conversations that have seen no packets for at least
+ * conversation_idle_timeout seconds of packet time, so that their
+ * state doesn't accumulate over a long-running capture.
+ */
+static void
+expire_idle_conversations(capture_file *cf, const wtap_rec *rec)
+{
+    conversation_idle_mark_t *mark, *expire_mark = NULL;
+    guint expired;
+
+    if (conversation_idle_timeout == 0 || !(rec->presence_flags & WTAP_HAS_TS))
+        return;
+
+    mark = (conversation_idle_mark_t *)g_queue_peek_tail(&conversation_idle_marks);
+    if (mark == NULL || rec->ts.secs - mark->ts.secs >= (time_t)conversation_idle_interval) {
+        mark = g_new(conversation_idle_mark_t, 1);
+        mark->ts = rec->ts;
+        mark->count = cf->count;
+        g_queue_push_tail(&conversation_idle_marks, mark);
+    }
+
+    /*
+     * Find the most recent sample at least conversation_idle_timeout
+     * old. Conversations whose last frame was at or before it have
+     * been idle for at least that long.
+     */
+    while ((mark = (conversation_idle_mark_t *)g_queue_peek_head(&conversation_idle_marks)) != NULL &&
+           rec->ts.secs - mark->ts.secs >= (time_t)conversation_idle_timeout) {
+        g_free(expire_mark);
+        expire_mark = (conversation_idle_mark_t *)g_queue_pop_head(&conversation_idle_marks);
+    }
+
+    if (expire_mark != NULL) {
+        expired = conversation_expire_before(expire_mark->count + 1);
+        ws_info("tshark: expired %u idle conversations before frame #%u", expired, expire_mark->count + 1);
+        g_free(expire_mark);
+    }
 }
@@ -0,0 +1,155 @@
+/* tap-dissectorprof.c
+ * Dissector profiling statistics for tshark
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/* This module provides "-z dissector,prof", which reports for each protocol
+ * how often its dissector was called and how much time was spent in it.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_tap_ui.h>
+
+#include <ui/cmdarg_err.h>
+
+void register_tap_listener_dissectorprof(void);
+
+static void
+dissectorprof_reset(void *pdp _U_)
+{
+	dissector_profiling_reset();
+}
+
+static void
+dissectorprof_collect(const dissector_profile_t *profile, gpointer user_data)
+{
+	GPtrArray *profiles = (GPtrArray *)user_data;
+
+	g_ptr_array_add(profiles, (gpointer)profile);
+}
+
+/* Most expensive protocols first. */
+static gint
+dissectorprof_compare(gconstpointer a, gconstpointer b)
+{
+	const dissector_profile_t *profile_a = *(const dissector_profile_t * const *)a;
+	const dissector_profile_t *profile_b = *(const dissector_profile_t * const *)b;
+
+	if (profile_a->self_ns != profile_b->self_ns)
+		return profile_a->self_ns < profile_b->self_ns ? 1 : -1;
+	return strcmp(profile_a->proto_name, profile_b->proto_name);
+}
+
+static void
+dissectorprof_draw(void *pdp _U_)
+{
+	GPtrArray *profiles = g_ptr_array_new();
+	const dissector_profile_t *profile;
+	guint64 total_self_ns = 0;
+	guint i;
+
+	dissector_profiling_foreach(dissectorprof_collect, profiles);
+	g_ptr_array_sort(profiles, dissectorprof_compare);
+
+	for (i = 0; i < profiles->len; i++) {
+		profile = (const dissector_profile_t *)g_ptr_array_index(profiles, i);
+		total_self_ns += profile->self_ns;
+	}
+
+	printf("\n");
+	printf("===================================================================\n");
+	printf("Dissector Profile\n");
+	printf("Time is in milliseconds. \"Self\" excludes time spent in sub-dissectors.\n");
+	printf("Packet and file bytes are allocated by the dissector itself.\n");
+	printf("%-24s %12s %10s %12s %12s %7s %10s %14s %14s\n",
+		"Protocol", "Calls", "Exceptions", "Total", "Self", "Self%", "ns/call",
+		"Packet bytes", "File bytes");
+	for (i = 0; i < profiles->len; i++) {
+		profile = (const dissector_profile_t *)g_ptr_array_index(profiles, i);
+		printf("%-24s %12" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT " %12.3f %12.3f %6.2f%% %10" G_GUINT64_FORMAT
+			" %14" G_GUINT64_FORMAT " %14" G_GUINT64_FORMAT "\n",
+			profile->proto_name, profile->calls, profile->exceptions,
+			profile->total_ns / 1e6, profile->self_ns / 1e6,
+			total_self_ns ? 100.0 * profile->self_ns / total_self_ns : 0.0,
+			profile->calls ? profile->self_ns / profile->calls : 0,
+			profile->self_packet_bytes, profile->self_file_bytes);
+	}
+	printf("===================================================================\n");
+
+	g_ptr_array_free(profiles, TRUE);
+}
+
+static void
+dissectorprof_finish(void *pdp _U_)
+{
+	dissector_profiling_enable(FALSE);
+}
+
+static void
+dissectorprof_init(const char *opt_arg, void *userdata _U_)
+{
+	GString *error_string;
+
+	if (strcmp("dissector,prof", opt_arg) != 0) {
+		cmdarg_err("invalid \"-z dissector,prof\" argument");
+		exit(1);
+	}
+
+	dissector_profiling_reset();
+	dissector_profiling_enable(TRUE);
+
+	/*
+	 * Profiles are accumulated per protocol over every dissector call,
+	 * not per packet, so the listener has no filter and no per-packet
+	 * callback.
+	 */
+	error_string = register_tap_listener("frame", NULL, NULL, TL_REQUIRES_NOTHING, dissectorprof_reset, NULL, dissectorprof_draw, dissectorprof_finish);
+	if (error_string) {
+		dissector_profiling_enable(FALSE);
+
+		cmdarg_err("Couldn't register dissector,prof tap: %s",
+			error_string->str);
+		g_string_free(error_string, TRUE);
+		exit(1);
+	}
+}
+
+static stat_tap_ui dissectorprof_ui = {
+	REGISTER_STAT_GROUP_GENERIC,
+	NULL,
+	"dissector,prof",
+	dissectorprof_init,
+	0,
+	NULL
+};
+
+void
+register_tap_listener_dissectorprof(void)
+{
+	register_stat_tap_ui(&dissectorprof_ui, NULL);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 8
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * End:
+ *
+ * vi: set shiftwidth=8 tabstop=8 noexpandtab:
+ * :indentSize=8:tabSize=8:noTabs=false:
+ */
@@ -0,0 +1,144 @@
+/* tap-heurstat.c
+ * Heuristic dissector statistics for tshark
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/* This module provides "-z heur,stat", which reports how often each
+ * heuristic dissector was tried and how often it accepted a packet.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_tap_ui.h>
+
+#include <ui/cmdarg_err.h>
+
+void register_tap_listener_heurstat(void);
+
+static void
+heurstat_reset(void *phs _U_)
+{
+	heur_dissector_reset_stats();
+}
+
+static void
+heurstat_collect_entry(const gchar *table_name _U_, heur_dtbl_entry_t *hdtbl_entry, gpointer user_data)
+{
+	GPtrArray *entries = (GPtrArray *)user_data;
+
+	if (hdtbl_entry->tries > 0)
+		g_ptr_array_add(entries, hdtbl_entry);
+}
+
+static void
+heurstat_collect_table(const char *table_name, struct heur_dissector_list *table _U_, gpointer user_data)
+{
+	heur_dissector_table_foreach(table_name, heurstat_collect_entry, user_data);
+}
+
+/* Most-tried heuristics first; they are the ones costing the most. */
+static gint
+heurstat_compare(gconstpointer a, gconstpointer b)
+{
+	const heur_dtbl_entry_t *entry_a = *(const heur_dtbl_entry_t * const *)a;
+	const heur_dtbl_entry_t *entry_b = *(const heur_dtbl_entry_t * const *)b;
+
+	if (entry_a->tries != entry_b->tries)
+		return entry_a->tries < entry_b->tries ? 1 : -1;
+	return strcmp(entry_a->short_name, entry_b->short_name);
+}
+
+static void
+heurstat_draw(void *phs _U_)
+{
+	GPtrArray *entries = g_ptr_array_new();
+	heur_dtbl_entry_t *hdtbl_entry;
+	guint64 total_tries = 0;
+	guint i;
+
+	dissector_all_heur_tables_foreach_table(heurstat_collect_table, entries, (GCompareFunc)g_strcmp0);
+	g_ptr_array_sort(entries, heurstat_compare);
+
+	printf("\n");
+	printf("===================================================================\n");
+	printf("Heuristic Dissector Statistics\n");
+	printf("%-16s %-24s %12s %12s %8s\n", "Table", "Heuristic", "Tries", "Accepted", "Rate");
+	for (i = 0; i < entries->len; i++) {
+		hdtbl_entry = (heur_dtbl_entry_t *)g_ptr_array_index(entries, i);
+		total_tries += hdtbl_entry->tries;
+		printf("%-16s %-24s %12" G_GUINT64_FORMAT " %12" G_GUINT64_FORMAT " %7.2f%%\n",
+			hdtbl_entry->list_name, hdtbl_entry->short_name,
+			hdtbl_entry->tries, hdtbl_entry->hits,
+			100.0 * (double)hdtbl_entry->hits / (double)hdtbl_entry->tries);
+	}
+	printf("Total heuristic calls: %" G_GUINT64_FORMAT "\n", total_tries);
+	printf("===================================================================\n");
+
+	g_ptr_array_free(entries, TRUE);
+}
+
+static void
+heurstat_init(const char *opt_arg, void *userdata _U_)
+{
+	GString *error_string;
+
+	if (strcmp("heur,stat", opt_arg) != 0) {
+		cmdarg_err("invalid \"-z heur,stat\" argument");
+		exit(1);
+	}
+
+	/* The counters are process-wide; start from zero for this run. */
+	heur_dissector_reset_stats();
+
+	/*
+	 * The counters are kept per heuristic entry, not per packet, so the
+	 * listener has no filter and no per-packet callback; it only resets
+	 * and prints them.
+	 */
+	error_string = register_tap_listener("frame", NULL, NULL, TL_REQUIRES_NOTHING, heurstat_reset, NULL, heurstat_draw, NULL);
+	if (error_string) {
+		cmdarg_err("Couldn't register heur,stat tap: %s",
+			error_string->str);
+		g_string_free(error_string, TRUE);
+		exit(1);
+	}
+}
+
+static stat_tap_ui heurstat_ui = {
+	REGISTER_STAT_GROUP_GENERIC,
+	NULL,
+	"heur,stat",
+	heurstat_init,
+	0,
+	NULL
+};
+
+void
+register_tap_listener_heurstat(void)
+{
+	register_stat_tap_ui(&heurstat_ui, NULL);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 8
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * End:
+ *
+ * vi: set shiftwidth=8 tabstop=8 noexpandtab:
+ * :indentSize=8:tabSize=8:noTabs=false:
+ */
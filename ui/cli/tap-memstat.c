@@ -0,0 +1,107 @@
+/* tap-memstat.c
+ * Memory usage statistics for tshark
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/* This module provides "-z mem,stat", which reports the memory used by the
+ * process and by the wmem file and epan scopes after the capture was read.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epan/packet.h>
+#include <epan/tap.h>
+#include <epan/stat_tap_ui.h>
+#include <epan/app_mem_usage.h>
+
+#include <ui/cmdarg_err.h>
+
+void register_tap_listener_memstat(void);
+
+static void
+memstat_draw_scope(const char *name, wmem_allocator_t *scope)
+{
+	wmem_allocator_stats_t stats;
+
+	wmem_get_stats(scope, &stats);
+	printf("%-16s %14" G_GUINT64_FORMAT " %16" G_GUINT64_FORMAT " %16" G_GUINT64_FORMAT "\n",
+		name, stats.allocs, stats.bytes_allocated, stats.peak_bytes_allocated);
+}
+
+static void
+memstat_draw(void *pms _U_)
+{
+	const char *name;
+	gsize value;
+	guint i;
+
+	printf("\n");
+	printf("===================================================================\n");
+	printf("Memory Statistics\n");
+	printf("%-32s %16s\n", "Component", "Bytes");
+	for (i = 0; (name = memory_usage_get(i, &value)) != NULL; i++) {
+		printf("%-32s %16" G_GSIZE_FORMAT "\n", name, value);
+	}
+	printf("\n");
+	printf("%-16s %14s %16s %16s\n", "wmem scope", "Allocations", "Bytes allocated", "Peak allocated");
+	memstat_draw_scope("file", wmem_file_scope());
+	memstat_draw_scope("epan", wmem_epan_scope());
+	printf("===================================================================\n");
+}
+
+static void
+memstat_init(const char *opt_arg, void *userdata _U_)
+{
+	GString *error_string;
+
+	if (strcmp("mem,stat", opt_arg) != 0) {
+		cmdarg_err("invalid \"-z mem,stat\" argument");
+		exit(1);
+	}
+
+	/* Nothing is collected per packet; the listener is only there to be drawn at the end. */
+	error_string = register_tap_listener("frame", NULL, NULL, TL_REQUIRES_NOTHING, NULL, NULL, memstat_draw, NULL);
+	if (error_string) {
+		cmdarg_err("Couldn't register mem,stat tap: %s",
+			error_string->str);
+		g_string_free(error_string, TRUE);
+		exit(1);
+	}
+}
+
+static stat_tap_ui memstat_ui = {
+	REGISTER_STAT_GROUP_GENERIC,
+	NULL,
+	"mem,stat",
+	memstat_init,
+	0,
+	NULL
+};
+
+void
+register_tap_listener_memstat(void)
+{
+	register_stat_tap_ui(&memstat_ui, NULL);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 8
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * End:
+ *
+ * vi: set shiftwidth=8 tabstop=8 noexpandtab:
+ * :indentSize=8:tabSize=8:noTabs=false:
+ */
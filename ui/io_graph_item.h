@@ -396,6 +396,99 @@ update_io_graph_item(io_graph_item_t *items, int idx, packet_info *pinfo, epan_d
     return TRUE;
 }
 
+/** Merge the values of one io_graph_item_t into another.
+ *
+ * This lets a graph switch to a coarser interval without retapping.
+ * src must cover a later time span than anything already merged into dst.
+ * LOAD values are spread across intervals when tapped and cannot be merged.
+ *
+ * @param dst [in,out] Item to merge into.
+ * @param src [in] Item to merge from.
+ * @param hf_index [in] Header field index for advanced statistics.
+ * @param item_unit [in] The type of unit to calculate. From IOG_ITEM_UNITS.
+ */
+static inline void
+merge_io_graph_item(io_graph_item_t *dst, const io_graph_item_t *src, int hf_index, int item_unit) {
+    gboolean take_max = FALSE, take_min = FALSE;
+
+    if (src->frames == 0) {
+        return;
+    }
+
+    if (dst->first_frame_in_invl == 0) {
+        dst->first_frame_in_invl = src->first_frame_in_invl;
+    }
+    dst->last_frame_in_invl = src->last_frame_in_invl;
+
+    if (hf_index >= 0 && src->fields > 0) {
+        switch (proto_registrar_get_ftype(hf_index)) {
+        case FT_UINT8:
+        case FT_UINT16:
+        case FT_UINT24:
+        case FT_UINT32:
+        case FT_UINT40:
+        case FT_UINT48:
+        case FT_UINT56:
+        case FT_UINT64:
+            take_max = (guint64)src->int_max > (guint64)dst->int_max;
+            take_min = (guint64)src->int_min < (guint64)dst->int_min;
+            break;
+        case FT_INT8:
+        case FT_INT16:
+        case FT_INT24:
+        case FT_INT32:
+        case FT_INT40:
+        case FT_INT48:
+        case FT_INT56:
+        case FT_INT64:
+            take_max = src->int_max > dst->int_max;
+            take_min = src->int_min < dst->int_min;
+            break;
+        case FT_FLOAT:
+            take_max = src->float_max > dst->float_max;
+            take_min = src->float_min < dst->float_min;
+            break;
+        case FT_DOUBLE:
+            take_max = src->double_max > dst->double_max;
+            take_min = src->double_min < dst->double_min;
+            break;
+        case FT_RELATIVE_TIME:
+            take_max = nstime_cmp(&src->time_max, &dst->time_max) > 0;
+            take_min = nstime_cmp(&src->time_min, &dst->time_min) < 0;
+            break;
+        default:
+            break;
+        }
+
+        if (take_max || dst->fields == 0) {
+            dst->int_max = src->int_max;
+            dst->float_max = src->float_max;
+            dst->double_max = src->double_max;
+            dst->time_max = src->time_max;
+            if (item_unit == IOG_ITEM_UNIT_CALC_MAX) {
+                dst->extreme_frame_in_invl = src->extreme_frame_in_invl;
+            }
+        }
+        if (take_min || dst->fields == 0) {
+            dst->int_min = src->int_min;
+            dst->float_min = src->float_min;
+            dst->double_min = src->double_min;
+            dst->time_min = src->time_min;
+            if (item_unit == IOG_ITEM_UNIT_CALC_MIN) {
+                dst->extreme_frame_in_invl = src->extreme_frame_in_invl;
+            }
+        }
+        dst->int_tot += src->int_tot;
+        dst->float_tot += src->float_tot;
+        dst->double_tot += src->double_tot;
+        nstime_add(&dst->time_tot, &src->time_tot);
+        dst->fields += src->fields;
+    }
+
+    dst->frames += src->frames;
+    dst->bytes += src->bytes;
+}
+
 
 #ifdef __cplusplus
 }
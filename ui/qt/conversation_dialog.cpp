@@ -362,11 +362,7 @@ public:
         conv_array_(conv_array),
         conv_idx_(conv_idx),
         resolve_names_ptr_(resolve_names_ptr)
-    {
-        QString timeline_tt = QObject::tr("Bars show the relative timeline for each conversation.");
-        setToolTip(CONV_COLUMN_START, timeline_tt);
-        setToolTip(CONV_COLUMN_DURATION, timeline_tt);
-    }
+    {}
 
     conv_item_t *convItem() {
         return &g_array_index(conv_array_, conv_item_t, conv_idx_);
@@ -465,6 +461,23 @@ public:
 
             break;
         }
+        // Alignment and tool tips are the same for every row. Return them
+        // here instead of storing them in each of what can be millions of
+        // items.
+        case Qt::TextAlignmentRole:
+            switch (column) {
+            case CONV_COLUMN_SRC_ADDR:
+            case CONV_COLUMN_DST_ADDR:
+                break;
+            default:
+                return int(Qt::AlignRight);
+            }
+            break;
+        case Qt::ToolTipRole:
+            if (column == CONV_COLUMN_START || column == CONV_COLUMN_DURATION) {
+                return QObject::tr("Bars show the relative timeline for each conversation.");
+            }
+            break;
         default:
             break;
         }
@@ -848,41 +861,24 @@ void ConversationTreeWidget::updateItems() {
     setSortingEnabled(false);
 
     QList<QTreeWidgetItem *>new_items;
+    new_items.reserve((int) hash_.conv_array->len - topLevelItemCount());
     for (int i = topLevelItemCount(); i < (int) hash_.conv_array->len; i++) {
-        ConversationTreeWidgetItem *ctwi = new ConversationTreeWidgetItem(hash_.conv_array, i, &resolve_names_);
-        new_items << ctwi;
-
-        if (i == 0) {
-            min_rel_start_time_ = nstime_to_sec(&(ctwi->convItem()->start_time));
-            max_rel_stop_time_ = nstime_to_sec(&(ctwi->convItem()->stop_time));
-        }
-
-        for (int col = 0; col < columnCount(); col++) {
-            switch (col) {
-            case CONV_COLUMN_SRC_ADDR:
-            case CONV_COLUMN_DST_ADDR:
-            break;
-            default:
-                ctwi->setTextAlignment(col, Qt::AlignRight);
-                break;
-            }
-        }
+        new_items << new ConversationTreeWidgetItem(hash_.conv_array, i, &resolve_names_);
     }
     addTopLevelItems(new_items);
 
-    for (int i = 0; i < topLevelItemCount(); i++) {
-        ConversationTreeWidgetItem *ctwi = dynamic_cast<ConversationTreeWidgetItem *>(topLevelItem(i));
-
-        if (ctwi) {
-            double item_rel_start = nstime_to_sec(&(ctwi->convItem()->start_time));
-            if (item_rel_start < min_rel_start_time_) {
-                min_rel_start_time_ = item_rel_start;
-            }
+    // Every row maps to the same index in conv_array, so scan that
+    // directly rather than looking up and casting each tree item.
+    for (guint i = 0; i < hash_.conv_array->len; i++) {
+        conv_item_t *conv_item = &g_array_index(hash_.conv_array, conv_item_t, i);
+        double item_rel_start = nstime_to_sec(&conv_item->start_time);
+        double item_rel_stop = nstime_to_sec(&conv_item->stop_time);
 
-            double item_rel_stop = nstime_to_sec(&(ctwi->convItem()->stop_time));
-            if (item_rel_stop > max_rel_stop_time_) {
-                max_rel_stop_time_ = item_rel_stop;
-            }
+        if (i == 0 || item_rel_start < min_rel_start_time_) {
+            min_rel_start_time_ = item_rel_start;
+        }
+        if (i == 0 || item_rel_stop > max_rel_stop_time_) {
+            max_rel_stop_time_ = item_rel_stop;
         }
     }
 
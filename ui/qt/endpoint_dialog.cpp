@@ -472,6 +472,10 @@ public:
         if (role == Qt::UserRole + 1) {
             return VariantPointer<const mmdb_lookup_t>::asQVariant(mmdbLookup());
         }
+        // The same for every row, so don't store it in each item.
+        if (role == Qt::TextAlignmentRole && column != ENDP_COLUMN_ADDR && column < ENDP_NUM_COLUMNS) {
+            return int(Qt::AlignRight);
+        }
         return QTreeWidgetItem::data(column, role);
     }
 
@@ -792,16 +796,11 @@ void EndpointTreeWidget::updateItems()
     setSortingEnabled(false);
 
     QList<QTreeWidgetItem *>new_items;
+    new_items.reserve((int) hash_.conv_array->len - topLevelItemCount());
     for (int i = topLevelItemCount(); i < (int) hash_.conv_array->len; i++) {
         EndpointTreeWidgetItem *etwi = new EndpointTreeWidgetItem(hash_.conv_array, i, &resolve_names_);
         new_items << etwi;
 
-        for (int col = 0; col < columnCount(); col++) {
-            if (col != ENDP_COLUMN_ADDR && col < ENDP_NUM_COLUMNS) {
-                etwi->setTextAlignment(col, Qt::AlignRight);
-            }
-        }
-
 #ifdef HAVE_MAXMINDDB
         // Assume that an asynchronous MMDB lookup has completed before (for
         // example, in the dissection tree). If so, then we do not have to check
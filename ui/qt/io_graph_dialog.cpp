@@ -1242,8 +1242,9 @@ void IOGraphDialog::on_intervalComboBox_currentIndexChanged(int)
         for (int row = 0; row < uat_model_->rowCount(); row++) {
             IOGraph *iog = ioGraphs_.value(row, NULL);
             if (iog) {
-                iog->setInterval(interval);
-                if (iog->visible()) {
+                // Hidden graphs keep their items too, so a graph that
+                // can't be rebucketed needs a retap even if it isn't shown.
+                if (!iog->setInterval(interval)) {
                     need_retap = true;
                 }
             }
@@ -1252,6 +1253,8 @@ void IOGraphDialog::on_intervalComboBox_currentIndexChanged(int)
 
     if (need_retap) {
         scheduleRetap(true);
+    } else {
+        scheduleRecalc(true);
     }
 
     updateLegend();
@@ -1612,7 +1615,9 @@ IOGraph::IOGraph(QCustomPlot *parent) :
     bars_(NULL),
     val_units_(IOG_ITEM_UNIT_FIRST),
     hf_index_(-1),
-    cur_idx_(-1)
+    interval_(0),
+    cur_idx_(-1),
+    tapped_(false)
 {
     Q_ASSERT(parent_ != NULL);
     graph_ = parent_->addGraph(parent_->xAxis, parent_->yAxis);
@@ -2158,9 +2163,46 @@ bool IOGraph::hasItemToShow(int idx, double value) const
     return result;
 }
 
-void IOGraph::setInterval(int interval)
+// Returns true if the cached items are valid for the new interval. Coarser
+// intervals that are a multiple of the current one are built by merging
+// the existing items; anything else requires a retap.
+bool IOGraph::setInterval(int interval)
 {
+    if (interval == interval_) {
+        return true;
+    }
+
+    int old_interval = interval_;
     interval_ = interval;
+
+    if (!tapped_) {
+        return false;
+    }
+
+    // A graph that matched no packets is empty at any interval.
+    if (cur_idx_ < 0) {
+        return true;
+    }
+
+    if (old_interval <= 0 || interval % old_interval != 0
+            || cur_idx_ >= max_io_items_ - 1 || val_units_ == IOG_ITEM_UNIT_CALC_LOAD) {
+        return false;
+    }
+
+    int factor = interval / old_interval;
+    int new_cur_idx = cur_idx_ / factor;
+    for (int idx = 0; idx <= new_cur_idx; idx++) {
+        io_graph_item_t merged;
+        reset_io_graph_items(&merged, 1);
+        for (int old_idx = idx * factor; old_idx < (idx + 1) * factor && old_idx <= cur_idx_; old_idx++) {
+            merge_io_graph_item(&merged, &items_[old_idx], hf_index_, val_units_);
+        }
+        items_[idx] = merged;
+    }
+    reset_io_graph_items(&items_[new_cur_idx + 1], cur_idx_ - new_cur_idx);
+    cur_idx_ = new_cur_idx;
+
+    return true;
 }
 
 // Get the value at the given interval (idx) for the current value unit.
@@ -2179,6 +2221,7 @@ void IOGraph::tapReset(void *iog_ptr)
 
 //    qDebug() << "=tapReset" << iog->name_;
     iog->clearAllData();
+    iog->tapped_ = true;
 }
 
 // "tap_packet" callback for register_tap_listener
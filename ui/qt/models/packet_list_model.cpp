@@ -8,6 +8,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <glib.h>
 
 #include "packet_list_model.h"
@@ -168,6 +169,7 @@ void PacketListModel::clear() {
     visible_rows_.resize(0);
     new_visible_rows_.resize(0);
     number_to_row_.resize(0);
+    PacketListRecord::invalidateAllRecords();
     endResetModel();
     max_row_height_ = 0;
     max_line_count_ = 1;
@@ -342,6 +344,26 @@ capture_file *PacketListModel::sort_cap_file_;
 
 QElapsedTimer busy_timer_;
 const int busy_timeout_ = 65; // ms, approximately 15 fps
+
+static void updateBusyIndicator()
+{
+    if (busy_timer_.elapsed() > busy_timeout_) {
+        // What's the least amount of processing that we can do which will draw
+        // the busy indicator?
+        mainApp->processEvents(QEventLoop::ExcludeUserInputEvents | QEventLoop::ExcludeSocketNotifiers, 1);
+        busy_timer_.restart();
+    }
+}
+
+// Numeric sort key for a record, parsed once per sort instead of once per
+// comparison.
+struct NumericSortKey {
+    double value;
+    bool valid;
+    guint32 num;
+    PacketListRecord *record;
+};
+
 void PacketListModel::sort(int column, Qt::SortOrder order)
 {
     if (!cap_file_ || visible_rows_.count() < 1) return;
@@ -363,7 +385,44 @@ void PacketListModel::sort(int column, Qt::SortOrder order)
 
     busy_timer_.start();
     sort_column_is_numeric_ = isNumericColumn(sort_column_);
-    std::sort(physical_rows_.begin(), physical_rows_.end(), recordLessThan);
+    if (text_sort_column_ >= 0 && sort_column_is_numeric_) {
+        QVector<NumericSortKey> keys;
+        keys.reserve(physical_rows_.count());
+        foreach (PacketListRecord *record, physical_rows_) {
+            NumericSortKey key;
+            key.value = parseNumericColumn(record->columnString(sort_cap_file_, sort_column_), &key.valid);
+            key.num = record->frameData()->num;
+            key.record = record;
+            keys << key;
+            updateBusyIndicator();
+        }
+
+        // Same ordering as recordLessThan: values that can't be parsed go
+        // first, ties are broken by frame number.
+        bool ascending = sort_order_ == Qt::AscendingOrder;
+        std::sort(keys.begin(), keys.end(), [ascending](const NumericSortKey &k1, const NumericSortKey &k2) {
+            updateBusyIndicator();
+            int cmp_val;
+            if (k1.valid != k2.valid) {
+                cmp_val = k1.valid ? 1 : -1;
+            } else if (k1.valid && k1.value < k2.value) {
+                cmp_val = -1;
+            } else if (k1.valid && k2.value < k1.value) {
+                cmp_val = 1;
+            } else if (k1.num != k2.num) {
+                cmp_val = k1.num < k2.num ? -1 : 1;
+            } else {
+                cmp_val = 0;
+            }
+            return ascending ? cmp_val < 0 : cmp_val > 0;
+        });
+
+        for (qsizetype i = 0; i < keys.count(); i++) {
+            physical_rows_[i] = keys[i].record;
+        }
+    } else {
+        std::sort(physical_rows_.begin(), physical_rows_.end(), recordLessThan);
+    }
 
     beginResetModel();
     visible_rows_.resize(0);
@@ -465,12 +524,7 @@ bool PacketListModel::recordLessThan(PacketListRecord *r1, PacketListRecord *r2)
     // _packet_list_compare_records, and packet_list_compare_custom from
     // gtk/packet_list_store.c into one function
 
-    if (busy_timer_.elapsed() > busy_timeout_) {
-        // What's the least amount of processing that we can do which will draw
-        // the busy indicator?
-        mainApp->processEvents(QEventLoop::ExcludeUserInputEvents | QEventLoop::ExcludeSocketNotifiers, 1);
-        busy_timer_.restart();
-    }
+    updateBusyIndicator();
     if (sort_column_ < 0) {
         // No column.
         cmp_val = frame_data_compare(sort_cap_file_->epan, r1->frameData(), r2->frameData(), COL_NUMBER);
@@ -482,8 +536,8 @@ bool PacketListModel::recordLessThan(PacketListRecord *r1, PacketListRecord *r2)
             cmp_val = 0;
         } else if (sort_column_is_numeric_) {
             // Custom column with numeric data (or something like a port number).
-            // Attempt to convert to numbers.
-            // XXX This is slow. Can we avoid doing this?
+            // Attempt to convert to numbers. sort() normally parses each
+            // value once up front for these columns instead.
             bool ok_r1, ok_r2;
             double num_r1 = parseNumericColumn(r1->columnString(sort_cap_file_, sort_column_), &ok_r1);
             double num_r2 = parseNumericColumn(r2->columnString(sort_cap_file_, sort_column_), &ok_r2);
@@ -523,7 +577,9 @@ double PacketListModel::parseNumericColumn(const QString &val, bool *ok)
     const char *strval = ba.constData();
     gchar *end = NULL;
     double num = g_ascii_strtod(strval, &end);
-    *ok = strval != end;
+    // NaN doesn't order against anything, which would break the strict
+    // weak ordering std::sort relies on, so sort it with the non-numbers.
+    *ok = strval != end && !std::isnan(num);
     return num;
 }
 
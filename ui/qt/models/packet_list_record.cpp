@@ -26,6 +26,7 @@
 #include <QStringList>
 
 QMap<int, int> PacketListRecord::cinfo_column_;
+QSet<QString> PacketListRecord::col_text_pool_;
 unsigned PacketListRecord::col_data_ver_ = 1;
 unsigned PacketListRecord::rows_color_ver_ = 1;
 
@@ -90,6 +91,58 @@ const QString PacketListRecord::columnString(capture_file *cap_file, int column,
     return col_text_.at(column);
 }
 
+// Protocol and address columns repeat the same handful of values across
+// the whole capture. Share a single copy of each instead of allocating a
+// new string for every row.
+const QString PacketListRecord::internColumnString(const QString &str)
+{
+    QSet<QString>::const_iterator it = col_text_pool_.constFind(str);
+    if (it != col_text_pool_.constEnd()) {
+        return *it;
+    }
+    col_text_pool_.insert(str);
+    return str;
+}
+
+// Formats whose values are few enough for interning to pay off. Ports,
+// custom columns and the like can be unique per row and would only grow
+// the pool.
+bool PacketListRecord::isLowCardinalityFormat(int col_fmt)
+{
+    switch (col_fmt) {
+    case COL_8021Q_VLAN_ID:
+    case COL_VSAN:
+    case COL_DEF_SRC:
+    case COL_RES_SRC:
+    case COL_UNRES_SRC:
+    case COL_DEF_DL_SRC:
+    case COL_RES_DL_SRC:
+    case COL_UNRES_DL_SRC:
+    case COL_DEF_NET_SRC:
+    case COL_RES_NET_SRC:
+    case COL_UNRES_NET_SRC:
+    case COL_DEF_DST:
+    case COL_RES_DST:
+    case COL_UNRES_DST:
+    case COL_DEF_DL_DST:
+    case COL_RES_DL_DST:
+    case COL_UNRES_DL_DST:
+    case COL_DEF_NET_DST:
+    case COL_RES_NET_DST:
+    case COL_UNRES_NET_DST:
+    case COL_DSCP_VALUE:
+    case COL_EXPERT:
+    case COL_FREQ_CHAN:
+    case COL_IF_DIR:
+    case COL_PROTOCOL:
+    case COL_TEI:
+    case COL_TX_RATE:
+        return true;
+    default:
+        return false;
+    }
+}
+
 void PacketListRecord::resetColumns(column_info *cinfo)
 {
     invalidateAllRecords();
@@ -225,6 +278,7 @@ void PacketListRecord::cacheColumnStrings(column_info *cinfo)
     }
 
     col_text_.clear();
+    col_text_.reserve(cinfo->num_cols);
     lines_ = 1;
     line_count_changed_ = false;
 
@@ -301,6 +355,10 @@ void PacketListRecord::cacheColumnStrings(column_info *cinfo)
             col_str = QString(cinfo->columns[column].col_data);
         }
 
+        if (isLowCardinalityFormat(cinfo->columns[column].col_fmt)) {
+            col_str = internColumnString(col_str);
+        }
+
         col_text_ << col_str;
         col_lines = static_cast<int>(col_str.count('\n'));
         if (col_lines > lines_) {
@@ -21,6 +21,7 @@
 
 #include <QByteArray>
 #include <QList>
+#include <QSet>
 #include <QVariant>
 
 struct conversation;
@@ -43,7 +44,7 @@ public:
     unsigned int conversation() { return conv_index_; }
 
     int columnTextSize(const char *str);
-    static void invalidateAllRecords() { col_data_ver_++; }
+    static void invalidateAllRecords() { col_data_ver_++; col_text_pool_.clear(); }
     static void resetColumns(column_info *cinfo);
     static void resetColorization() { rows_color_ver_++; }
 
@@ -59,6 +60,11 @@ private:
     bool line_count_changed_;
     static QMap<int, int> cinfo_column_;
 
+    /** Column text shared between records, e.g. protocols and addresses */
+    static QSet<QString> col_text_pool_;
+    static const QString internColumnString(const QString &str);
+    static bool isLowCardinalityFormat(int col_fmt);
+
     /** Data versions. Used to invalidate col_text_ */
     static unsigned col_data_ver_;
     unsigned data_ver_;
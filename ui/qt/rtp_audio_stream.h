@@ -186,8 +186,10 @@ private:
     struct SpeexResamplerState_ *audio_resampler_;
     struct SpeexResamplerState_ *visual_resampler_;
     QAudioOutput *audio_output_;
-    QMap<double, quint32> packet_timestamps_;
     QVector<qint16> visual_samples_;
+    // Relative timestamp and frame number of each entry in visual_samples_
+    QVector<double> visual_timestamps_;
+    QVector<quint32> visual_frame_nums_;
     QVector<double> out_of_seq_timestamps_;
     QVector<double> jitter_drop_timestamps_;
     QVector<double> wrong_timestamp_timestamps_;
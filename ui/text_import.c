@@ -394,9 +394,20 @@ static import_status_t
 write_byte(const char *str)
 {
     guint32 num;
+    int hi, lo;
 
-    if (parse_num(str, FALSE, &num) != IMPORT_SUCCESS)
+    /*
+     * Byte tokens from the scanner start with exactly two hex digits;
+     * decode those directly, as going through strtoul() for every byte
+     * dominates the time spent importing large hex dumps.
+     */
+    hi = (str != NULL) ? g_ascii_xdigit_value(str[0]) : -1;
+    lo = (hi >= 0) ? g_ascii_xdigit_value(str[1]) : -1;
+    if (lo >= 0) {
+        num = (guint32) (hi << 4 | lo);
+    } else if (parse_num(str, FALSE, &num) != IMPORT_SUCCESS) {
         return IMPORT_FAILURE;
+    }
 
     packet_buf[curr_offset] = (guint8) num;
     curr_offset++;
@@ -294,6 +294,10 @@ voip_calls_reset_all_taps(voip_calls_tapinfo_t *tapinfo)
     }
     g_list_free(tapinfo->rtpstream_list);
     tapinfo->rtpstream_list = NULL;
+    if (tapinfo->rtpstream_hashtable) {
+        g_hash_table_destroy(tapinfo->rtpstream_hashtable);
+        tapinfo->rtpstream_hashtable = NULL;
+    }
 
     if (tapinfo->h245_labels) {
         memset(tapinfo->h245_labels, 0, sizeof(h245_labels_t));
@@ -592,6 +596,10 @@ rtp_reset(void *tap_offset_ptr)
     }
     g_list_free(tapinfo->rtpstream_list);
     tapinfo->rtpstream_list = NULL;
+    if (tapinfo->rtpstream_hashtable) {
+        g_hash_table_destroy(tapinfo->rtpstream_hashtable);
+        tapinfo->rtpstream_hashtable = NULL;
+    }
     tapinfo->nrtpstreams = 0;
 
     // Do not touch graph_analysis, it is handled by caller
@@ -611,7 +619,7 @@ rtp_packet(void *tap_offset_ptr, packet_info *pinfo, epan_dissect_t *edt, void c
     voip_calls_tapinfo_t *tapinfo = tap_id_to_base(tap_offset_ptr, tap_id_offset_rtp_);
     rtpstream_info_t    *tmp_listinfo;
     rtpstream_info_t    *strinfo = NULL;
-    GList                *list;
+    guint64              stream_key;
     struct _rtp_conversation_info *p_conv_data = NULL;
 
     const struct _rtp_info *rtp_info = (const struct _rtp_info *)rtp_info_ptr;
@@ -630,31 +638,31 @@ rtp_packet(void *tap_offset_ptr, packet_info *pinfo, epan_dissect_t *edt, void c
         tapinfo->tap_packet(tapinfo, pinfo, edt, rtp_info_ptr);
     }
 
-    /* check whether we already have a RTP stream with this setup frame and ssrc in the list */
-    list = g_list_first(tapinfo->rtpstream_list);
-    while (list)
-    {
-        tmp_listinfo=(rtpstream_info_t *)list->data;
-        if ( (tmp_listinfo->setup_frame_number == rtp_info->info_setup_frame_num)
-                && (tmp_listinfo->id.ssrc == rtp_info->info_sync_src) && (tmp_listinfo->end_stream == FALSE)) {
-            /* if the payload type has changed, we mark the stream as finished to create a new one
-               this is to show multiple payload changes in the Graph for example for DTMF RFC2833 */
-            if ( tmp_listinfo->first_payload_type != rtp_info->info_payload_type ) {
-                tmp_listinfo->end_stream = TRUE;
-            } else if ( ( ( tmp_listinfo->ed137_info == NULL ) && (rtp_info->info_ed137_info != NULL) ) ||
-                        ( ( tmp_listinfo->ed137_info != NULL ) && (rtp_info->info_ed137_info == NULL) ) ||
-                        ( ( tmp_listinfo->ed137_info != NULL ) && (rtp_info->info_ed137_info != NULL) &&
-                          ( 0!=strcmp(tmp_listinfo->ed137_info, rtp_info->info_ed137_info) )
-                        )
-                      ) {
-            /* if ed137_info has changed, create new stream */
-                tmp_listinfo->end_stream = TRUE;
-            } else {
-                strinfo = (rtpstream_info_t*)(list->data);
-                break;
-            }
+    /* check whether we already have an open RTP stream with this setup frame and ssrc */
+    if (!tapinfo->rtpstream_hashtable) {
+        tapinfo->rtpstream_hashtable = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, NULL);
+    }
+    stream_key = ((guint64)rtp_info->info_setup_frame_num << 32) | rtp_info->info_sync_src;
+    tmp_listinfo = (rtpstream_info_t *)g_hash_table_lookup(tapinfo->rtpstream_hashtable, &stream_key);
+    if (tmp_listinfo) {
+        /* if the payload type has changed, we mark the stream as finished to create a new one
+           this is to show multiple payload changes in the Graph for example for DTMF RFC2833 */
+        if ( tmp_listinfo->first_payload_type != rtp_info->info_payload_type ) {
+            tmp_listinfo->end_stream = TRUE;
+        } else if ( ( ( tmp_listinfo->ed137_info == NULL ) && (rtp_info->info_ed137_info != NULL) ) ||
+                    ( ( tmp_listinfo->ed137_info != NULL ) && (rtp_info->info_ed137_info == NULL) ) ||
+                    ( ( tmp_listinfo->ed137_info != NULL ) && (rtp_info->info_ed137_info != NULL) &&
+                      ( 0!=strcmp(tmp_listinfo->ed137_info, rtp_info->info_ed137_info) )
+                    )
+                  ) {
+        /* if ed137_info has changed, create new stream */
+            tmp_listinfo->end_stream = TRUE;
+        } else {
+            strinfo = tmp_listinfo;
+        }
+        if (tmp_listinfo->end_stream) {
+            g_hash_table_remove(tapinfo->rtpstream_hashtable, &stream_key);
         }
-        list = g_list_next(list);
     }
 
     /* if this is a duplicated RTP Event End, just return */
@@ -695,6 +703,7 @@ rtp_packet(void *tap_offset_ptr, packet_info *pinfo, epan_dissect_t *edt, void c
             strinfo->ed137_info = NULL;
         }
         tapinfo->rtpstream_list = g_list_prepend(tapinfo->rtpstream_list, strinfo);
+        g_hash_table_insert(tapinfo->rtpstream_hashtable, g_memdup2(&stream_key, sizeof(stream_key)), strinfo);
     }
 
     /* Add the info to the existing RTP stream */
@@ -707,6 +716,7 @@ rtp_packet(void *tap_offset_ptr, packet_info *pinfo, epan_dissect_t *edt, void c
         strinfo->rtp_event = tapinfo->rtp_evt;
         if (tapinfo->rtp_evt_end == TRUE) {
             strinfo->end_stream = TRUE;
+            g_hash_table_remove(tapinfo->rtpstream_hashtable, &stream_key);
         }
     }
 
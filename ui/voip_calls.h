@@ -193,6 +193,7 @@ typedef struct _voip_calls_tapinfo {
     epan_t               *session; /**< epan session */
     int                   nrtpstreams; /**< number of rtp streams */
     GList*                rtpstream_list; /**< list of rtpstream_info_t */
+    GHashTable*           rtpstream_hashtable; /**< open RTP streams (rtpstream_info_t) by setup frame and SSRC */
     guint32               rtp_evt_frame_num;
     guint8                rtp_evt;
     gboolean              rtp_evt_end;
@@ -2156,7 +2156,7 @@ wtap_dump_can_open(int file_type_subtype)
 	return TRUE;
 }
 
-#ifdef HAVE_ZLIB
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
 gboolean
 wtap_dump_can_compress(int file_type_subtype)
 {
@@ -2180,6 +2180,32 @@ wtap_dump_can_compress(int file_type_subtype _U_)
 }
 #endif
 
+/*
+ * Can we write files compressed with this compression type?
+ */
+static gboolean
+wtap_dump_compression_type_supported(wtap_compression_type compression_type)
+{
+	switch (compression_type) {
+
+	case WTAP_UNCOMPRESSED:
+		return TRUE;
+
+#ifdef HAVE_ZLIB
+	case WTAP_GZIP_COMPRESSED:
+		return TRUE;
+#endif
+
+#ifdef HAVE_ZSTD
+	case WTAP_ZSTD_COMPRESSED:
+		return TRUE;
+#endif
+
+	default:
+		return FALSE;
+	}
+}
+
 static gboolean wtap_dump_open_finish(wtap_dumper *wdh, int *err,
 				      gchar **err_info);
 
@@ -2235,8 +2261,9 @@ wtap_dump_init_dumper(int file_type_subtype, wtap_compression_type compression_t
 	   be written 100% sequentially, we can't compress it,
 	   because we can't go back and overwrite something we've
 	   already written. */
-	if (compression_type != WTAP_UNCOMPRESSED &&
-	    !wtap_dump_can_compress(file_type_subtype)) {
+	if (!wtap_dump_compression_type_supported(compression_type) ||
+	    (compression_type != WTAP_UNCOMPRESSED &&
+	     !wtap_dump_can_compress(file_type_subtype))) {
 		*err = WTAP_ERR_COMPRESSION_NOT_SUPPORTED;
 		return NULL;
 	}
@@ -2610,6 +2637,14 @@ wtap_dump_flush(wtap_dumper *wdh, int *err)
 			return FALSE;
 		}
 	} else
+#endif
+#ifdef HAVE_ZSTD
+	if (wdh->compression_type == WTAP_ZSTD_COMPRESSED) {
+		if (zstdwfile_flush((ZSTDWFILE_T)wdh->fh) == -1) {
+			*err = zstdwfile_geterr((ZSTDWFILE_T)wdh->fh);
+			return FALSE;
+		}
+	} else
 #endif
 	{
 		if (fflush((FILE *)wdh->fh) == EOF) {
@@ -2713,42 +2748,46 @@ wtap_dump_discard_decryption_secrets(wtap_dumper *wdh)
 }
 
 /* internally open a file for writing (compressed or not) */
-#ifdef HAVE_ZLIB
 static WFILE_T
 wtap_dump_file_open(wtap_dumper *wdh, const char *filename)
 {
-	if (wdh->compression_type == WTAP_GZIP_COMPRESSED) {
+	switch (wdh->compression_type) {
+
+#ifdef HAVE_ZLIB
+	case WTAP_GZIP_COMPRESSED:
 		return gzwfile_open(filename);
-	} else {
+#endif
+
+#ifdef HAVE_ZSTD
+	case WTAP_ZSTD_COMPRESSED:
+		return zstdwfile_open(filename);
+#endif
+
+	default:
 		return ws_fopen(filename, "wb");
 	}
 }
-#else
-static WFILE_T
-wtap_dump_file_open(wtap_dumper *wdh _U_, const char *filename)
-{
-	return ws_fopen(filename, "wb");
-}
-#endif
 
 /* internally open a file for writing (compressed or not) */
-#ifdef HAVE_ZLIB
 static WFILE_T
 wtap_dump_file_fdopen(wtap_dumper *wdh, int fd)
 {
-	if (wdh->compression_type == WTAP_GZIP_COMPRESSED) {
+	switch (wdh->compression_type) {
+
+#ifdef HAVE_ZLIB
+	case WTAP_GZIP_COMPRESSED:
 		return gzwfile_fdopen(fd);
-	} else {
+#endif
+
+#ifdef HAVE_ZSTD
+	case WTAP_ZSTD_COMPRESSED:
+		return zstdwfile_fdopen(fd);
+#endif
+
+	default:
 		return ws_fdopen(fd, "wb");
 	}
 }
-#else
-static WFILE_T
-wtap_dump_file_fdopen(wtap_dumper *wdh _U_, int fd)
-{
-	return ws_fdopen(fd, "wb");
-}
-#endif
 
 /* internally writing raw bytes (compressed or not) */
 gboolean
@@ -2767,6 +2806,18 @@ wtap_dump_file_write(wtap_dumper *wdh, const void *buf, size_t bufsize, int *err
 			return FALSE;
 		}
 	} else
+#endif
+#ifdef HAVE_ZSTD
+	if (wdh->compression_type == WTAP_ZSTD_COMPRESSED) {
+		nwritten = zstdwfile_write((ZSTDWFILE_T)wdh->fh, buf, (unsigned int) bufsize);
+		/*
+		 * zstdwfile_write() returns 0 on error.
+		 */
+		if (nwritten == 0) {
+			*err = zstdwfile_geterr((ZSTDWFILE_T)wdh->fh);
+			return FALSE;
+		}
+	} else
 #endif
 	{
 		errno = WTAP_ERR_CANT_WRITE;
@@ -2794,6 +2845,11 @@ wtap_dump_file_close(wtap_dumper *wdh)
 	if (wdh->compression_type == WTAP_GZIP_COMPRESSED)
 		return gzwfile_close((GZWFILE_T)wdh->fh);
 	else
+#endif
+#ifdef HAVE_ZSTD
+	if (wdh->compression_type == WTAP_ZSTD_COMPRESSED)
+		return zstdwfile_close((ZSTDWFILE_T)wdh->fh);
+	else
 #endif
 		return fclose((FILE *)wdh->fh);
 }
@@ -2801,7 +2857,7 @@ wtap_dump_file_close(wtap_dumper *wdh)
 gint64
 wtap_dump_file_seek(wtap_dumper *wdh, gint64 offset, int whence, int *err)
 {
-#ifdef HAVE_ZLIB
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
 	if (wdh->compression_type != WTAP_UNCOMPRESSED) {
 		*err = WTAP_ERR_CANT_SEEK_COMPRESSED;
 		return -1;
@@ -2822,7 +2878,7 @@ gint64
 wtap_dump_file_tell(wtap_dumper *wdh, int *err)
 {
 	gint64 rval;
-#ifdef HAVE_ZLIB
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
 	if (wdh->compression_type != WTAP_UNCOMPRESSED) {
 		*err = WTAP_ERR_CANT_SEEK_COMPRESSED;
 		return -1;
@@ -64,18 +64,20 @@
 static struct compression_type {
     wtap_compression_type  type;
     const char            *extension;
+    const char            *name;
     const char            *description;
+    gboolean               can_write_compressed;
 } compression_types[] = {
 #ifdef HAVE_ZLIB
-    { WTAP_GZIP_COMPRESSED, "gz", "gzip compressed" },
+    { WTAP_GZIP_COMPRESSED, "gz", "gzip", "gzip compressed", TRUE },
 #endif
 #ifdef HAVE_ZSTD
-    { WTAP_ZSTD_COMPRESSED, "zst", "zstd compressed" },
+    { WTAP_ZSTD_COMPRESSED, "zst", "zstd", "zstd compressed", TRUE },
 #endif
 #ifdef USE_LZ4
-    { WTAP_LZ4_COMPRESSED, "lz4", "lz4 compressed" },
+    { WTAP_LZ4_COMPRESSED, "lz4", "lz4", "lz4 compressed", FALSE },
 #endif
-    { WTAP_UNCOMPRESSED, NULL, NULL }
+    { WTAP_UNCOMPRESSED, NULL, NULL, NULL, FALSE }
 };
 
 static wtap_compression_type file_get_compression_type(FILE_T stream);
@@ -122,6 +124,36 @@ wtap_get_all_compression_type_extensions_list(void)
 	return extensions;
 }
 
+wtap_compression_type
+wtap_name_to_compression_type(const char *name)
+{
+	if (strcmp(name, "none") == 0)
+		return WTAP_UNCOMPRESSED;
+
+	for (struct compression_type *p = compression_types;
+	    p->type != WTAP_UNCOMPRESSED; p++) {
+		if (p->can_write_compressed && strcmp(name, p->name) == 0)
+			return p->type;
+	}
+	return WTAP_UNKNOWN_COMPRESSION;
+}
+
+GSList *
+wtap_get_all_output_compression_type_names_list(void)
+{
+	GSList *names;
+
+	names = NULL;	/* empty list, to start with */
+
+	for (struct compression_type *p = compression_types;
+	    p->type != WTAP_UNCOMPRESSED; p++) {
+		if (p->can_write_compressed)
+			names = g_slist_prepend(names, (gpointer)p->name);
+	}
+
+	return names;
+}
+
 /* #define GZBUFSIZE 8192 */
 #define GZBUFSIZE 4096
 
@@ -2221,6 +2253,194 @@ gzwfile_geterr(GZWFILE_T state)
 }
 #endif
 
+#ifdef HAVE_ZSTD
+/* internal zstd file state data structure for writing */
+struct wtap_zstd_writer {
+    int fd;                 /* file descriptor */
+    ZSTD_CStream *cstream;  /* compression context */
+    unsigned char *out;     /* output buffer */
+    size_t size;            /* output buffer size */
+    int err;                /* error code; libzstd errors are WTAP_ERR_INTERNAL */
+};
+
+ZSTDWFILE_T
+zstdwfile_open(const char *path)
+{
+    int fd;
+    ZSTDWFILE_T state;
+    int save_errno;
+
+    fd = ws_open(path, O_BINARY|O_WRONLY|O_CREAT|O_TRUNC, 0666);
+    if (fd == -1)
+        return NULL;
+    state = zstdwfile_fdopen(fd);
+    if (state == NULL) {
+        save_errno = errno;
+        ws_close(fd);
+        errno = save_errno;
+    }
+    return state;
+}
+
+ZSTDWFILE_T
+zstdwfile_fdopen(int fd)
+{
+    ZSTDWFILE_T state;
+
+    /* allocate wtap_zstd_writer structure to return */
+    state = (ZSTDWFILE_T)g_try_malloc(sizeof *state);
+    if (state == NULL)
+        return NULL;
+    state->fd = fd;
+    state->size = ZSTD_CStreamOutSize();
+    state->out = (unsigned char *)g_try_malloc(state->size);
+    state->cstream = ZSTD_createCStream();
+    if (state->out == NULL || state->cstream == NULL ||
+        ZSTD_isError(ZSTD_initCStream(state->cstream, ZSTD_CLEVEL_DEFAULT))) {
+        ZSTD_freeCStream(state->cstream);
+        g_free(state->out);
+        g_free(state);
+        errno = ENOMEM;
+        return NULL;
+    }
+#if ZSTD_VERSION_NUMBER >= 10400
+    /*
+     * Let libzstd compress on worker threads, so that writing a
+     * compressed file isn't limited by a single core.  This fails
+     * if libzstd was built without multithreading support; in that
+     * case we just compress on this thread.
+     */
+    (void)ZSTD_CCtx_setParameter(state->cstream, ZSTD_c_nbWorkers,
+                                 (int)g_get_num_processors());
+#endif
+
+    state->err = 0;                 /* clear error */
+
+    /* return stream */
+    return state;
+}
+
+/* Write out the first len bytes of the output buffer.  Return -1, and
+   set state->err, on failure; return 0 on success. */
+static int
+zstd_write_out(ZSTDWFILE_T state, size_t len)
+{
+    ssize_t got;
+
+    if (len == 0)
+        return 0;
+    got = ws_write(state->fd, state->out, (unsigned int)len);
+    if (got < 0) {
+        state->err = errno;
+        return -1;
+    }
+    if ((size_t)got != len) {
+        state->err = WTAP_ERR_SHORT_WRITE;
+        return -1;
+    }
+    return 0;
+}
+
+/* Write out len bytes from buf.  Return 0, and set state->err, on
+   failure or on an attempt to write 0 bytes (in which case state->err
+   is 0); return the number of bytes written on success. */
+guint
+zstdwfile_write(ZSTDWFILE_T state, const void *buf, guint len)
+{
+    ZSTD_inBuffer input = { buf, len, 0 };
+    ZSTD_outBuffer output;
+    size_t ret;
+
+    /* check that there's no error */
+    if (state->err != 0)
+        return 0;
+
+    /* if len is zero, avoid unnecessary operations */
+    if (len == 0)
+        return 0;
+
+    /* compress until libzstd has taken all of the input */
+    while (input.pos < input.size) {
+        output.dst = state->out;
+        output.size = state->size;
+        output.pos = 0;
+        ret = ZSTD_compressStream(state->cstream, &output, &input);
+        if (ZSTD_isError(ret)) {
+            state->err = WTAP_ERR_INTERNAL;
+            return 0;
+        }
+        if (zstd_write_out(state, output.pos) == -1)
+            return 0;
+    }
+    return len;
+}
+
+/* Flush out what we've written so far.  Returns -1, and sets state->err,
+   on failure; returns 0 on success. */
+int
+zstdwfile_flush(ZSTDWFILE_T state)
+{
+    ZSTD_outBuffer output;
+    size_t remaining;
+
+    /* check that there's no error */
+    if (state->err != 0)
+        return -1;
+
+    do {
+        output.dst = state->out;
+        output.size = state->size;
+        output.pos = 0;
+        remaining = ZSTD_flushStream(state->cstream, &output);
+        if (ZSTD_isError(remaining)) {
+            state->err = WTAP_ERR_INTERNAL;
+            return -1;
+        }
+        if (zstd_write_out(state, output.pos) == -1)
+            return -1;
+    } while (remaining != 0);
+    return 0;
+}
+
+/* Finish the zstd frame, and close the file.  Returns a Wiretap
+   error on failure; returns 0 on success. */
+int
+zstdwfile_close(ZSTDWFILE_T state)
+{
+    ZSTD_outBuffer output;
+    size_t remaining;
+    int ret = state->err;
+
+    /* end the frame, free memory, and close file */
+    while (ret == 0) {
+        output.dst = state->out;
+        output.size = state->size;
+        output.pos = 0;
+        remaining = ZSTD_endStream(state->cstream, &output);
+        if (ZSTD_isError(remaining)) {
+            state->err = WTAP_ERR_INTERNAL;
+            ret = state->err;
+        } else if (zstd_write_out(state, output.pos) == -1) {
+            ret = state->err;
+        } else if (remaining == 0) {
+            break;
+        }
+    }
+    ZSTD_freeCStream(state->cstream);
+    g_free(state->out);
+    if (ws_close(state->fd) == -1 && ret == 0)
+        ret = errno;
+    g_free(state);
+    return ret;
+}
+
+int
+zstdwfile_geterr(ZSTDWFILE_T state)
+{
+    return state->err;
+}
+#endif /* HAVE_ZSTD */
+
 /*
  * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
  *
@@ -1795,7 +1795,8 @@ typedef enum {
     WTAP_UNCOMPRESSED,
     WTAP_GZIP_COMPRESSED,
     WTAP_ZSTD_COMPRESSED,
-    WTAP_LZ4_COMPRESSED
+    WTAP_LZ4_COMPRESSED,
+    WTAP_UNKNOWN_COMPRESSION
 } wtap_compression_type;
 
 WS_DLL_PUBLIC
@@ -1807,6 +1808,24 @@ const char *wtap_compression_type_extension(wtap_compression_type compression_ty
 WS_DLL_PUBLIC
 GSList *wtap_get_all_compression_type_extensions_list(void);
 
+/**
+ * Look up a compression type that can be used when writing, by the name
+ * used on the command line, e.g. "gzip" or "zstd".
+ *
+ * @param name The name; "none" gives WTAP_UNCOMPRESSED
+ * @return The compression type, or WTAP_UNKNOWN_COMPRESSION if the name
+ *         isn't known or this build can't write that type
+ */
+WS_DLL_PUBLIC
+wtap_compression_type wtap_name_to_compression_type(const char *name);
+
+/**
+ * Get the names of the compression types this build can write; the
+ * caller must free the list, but not the names.
+ */
+WS_DLL_PUBLIC
+GSList *wtap_get_all_output_compression_type_names_list(void);
+
 /*** get various information snippets about the current file ***/
 
 /** Return an approximation of the amount of data we've read sequentially
@@ -240,6 +240,29 @@ ws_clock_get_realtime(struct timespec *ts)
 #endif
 }
 
+guint64
+ws_clock_get_monotonic_ns(void)
+{
+#if defined(_WIN32)
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	if (frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (guint64)(counter.QuadPart / frequency.QuadPart) * 1000000000 +
+		(guint64)(counter.QuadPart % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+#elif defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+		return (guint64)ts.tv_sec * 1000000000 + (guint64)ts.tv_nsec;
+	return (guint64)g_get_monotonic_time() * 1000;
+#else
+	return (guint64)g_get_monotonic_time() * 1000;
+#endif
+}
+
 char *ws_strptime(const char *restrict s, const char *restrict format,
 			struct tm *restrict tm)
 {
@@ -65,6 +65,13 @@ guint64 create_timestamp(void);
 WS_DLL_PUBLIC
 struct timespec *ws_clock_get_realtime(struct timespec *ts);
 
+/**
+ * Fetch a monotonic clock reading in nanoseconds, suitable for measuring
+ * short intervals.  The starting point is arbitrary.
+ */
+WS_DLL_PUBLIC
+guint64 ws_clock_get_monotonic_ns(void);
+
 /*
  * Portability wrapper around strptime().
  */
@@ -16,6 +16,8 @@
 #include <glib.h>
 #include <string.h>
 
+#include "wmem_core.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -42,6 +44,9 @@ struct _wmem_allocator_t {
     void                        *private_data;
     enum _wmem_allocator_type_t  type;
     gboolean                     in_scope;
+
+    /* Accounting, see wmem_get_stats() */
+    wmem_allocator_stats_t       stats;
 };
 
 #ifdef __cplusplus
@@ -41,6 +41,9 @@ wmem_alloc(wmem_allocator_t *allocator, const size_t size)
         return NULL;
     }
 
+    allocator->stats.allocs++;
+    allocator->stats.bytes_allocated += size;
+
     return allocator->walloc(allocator->private_data, size);
 }
 
@@ -93,6 +96,8 @@ wmem_realloc(wmem_allocator_t *allocator, void *ptr, const size_t size)
 
     ASSERT(allocator->in_scope);
 
+    allocator->stats.bytes_allocated += size;
+
     return allocator->wrealloc(allocator->private_data, ptr, size);
 }
 
@@ -102,6 +107,12 @@ wmem_free_all_real(wmem_allocator_t *allocator, gboolean final)
     wmem_call_callbacks(allocator,
             final ? WMEM_CB_DESTROY_EVENT : WMEM_CB_FREE_EVENT);
     allocator->free_all(allocator->private_data);
+
+    if (allocator->stats.bytes_allocated > allocator->stats.peak_bytes_allocated) {
+        allocator->stats.peak_bytes_allocated = allocator->stats.bytes_allocated;
+    }
+    allocator->stats.allocs          = 0;
+    allocator->stats.bytes_allocated = 0;
 }
 
 void
@@ -116,6 +127,15 @@ wmem_gc(wmem_allocator_t *allocator)
     allocator->gc(allocator->private_data);
 }
 
+void
+wmem_get_stats(wmem_allocator_t *allocator, wmem_allocator_stats_t *stats)
+{
+    *stats = allocator->stats;
+    if (stats->bytes_allocated > stats->peak_bytes_allocated) {
+        stats->peak_bytes_allocated = stats->bytes_allocated;
+    }
+}
+
 void
 wmem_destroy_allocator(wmem_allocator_t *allocator)
 {
@@ -142,6 +162,7 @@ wmem_allocator_new(const wmem_allocator_type_t type)
     allocator->type      = real_type;
     allocator->callbacks = NULL;
     allocator->in_scope  = TRUE;
+    memset(&allocator->stats, 0, sizeof(allocator->stats));
 
     switch (real_type) {
         case WMEM_ALLOCATOR_SIMPLE:
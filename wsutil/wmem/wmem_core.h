@@ -61,6 +61,16 @@ typedef enum _wmem_allocator_type_t {
                 the next free_all is always just around the corner. */
 } wmem_allocator_type_t;
 
+/** Allocation counters kept for every allocator. They start over on each
+ * wmem_free_all(). They count what was requested, not what is held:
+ * individual frees aren't subtracted and a reallocation counts its full new
+ * size again. */
+typedef struct _wmem_allocator_stats_t {
+    guint64 allocs;               /**< Allocations since the last free_all */
+    guint64 bytes_allocated;      /**< Bytes requested since the last free_all */
+    guint64 peak_bytes_allocated; /**< Largest value bytes_allocated has reached */
+} wmem_allocator_stats_t;
+
 /** Allocate the requested amount of memory in the given pool.
  *
  * @param allocator The allocator object to use to allocate the memory.
@@ -181,6 +191,15 @@ WS_DLL_PUBLIC
 void
 wmem_gc(wmem_allocator_t *allocator);
 
+/** Fetch the allocation counters of an allocator.
+ *
+ * @param allocator The allocator to query.
+ * @param stats Filled in with the allocator's counters.
+ */
+WS_DLL_PUBLIC
+void
+wmem_get_stats(wmem_allocator_t *allocator, wmem_allocator_stats_t *stats);
+
 /** Destroy the given allocator, freeing all memory allocated in it. Once this
  * function has been called, no memory allocated with the allocator is valid.
  *
@@ -194,6 +194,41 @@ wmem_test_allocator_callbacks(void)
     g_assert_true(cb_called_count == 3);
 }
 
+static void
+wmem_test_allocator_stats(void)
+{
+    wmem_allocator_t       *allocator;
+    wmem_allocator_stats_t  stats;
+    void                   *ptr;
+
+    allocator = wmem_allocator_new(WMEM_ALLOCATOR_STRICT);
+
+    wmem_get_stats(allocator, &stats);
+    g_assert_true(stats.allocs == 0);
+    g_assert_true(stats.bytes_allocated == 0);
+    g_assert_true(stats.peak_bytes_allocated == 0);
+
+    wmem_alloc(allocator, 16);
+    ptr = wmem_alloc(allocator, 32);
+    wmem_realloc(allocator, ptr, 64);
+    wmem_alloc(allocator, 0);
+
+    wmem_get_stats(allocator, &stats);
+    g_assert_true(stats.allocs == 2);
+    g_assert_true(stats.bytes_allocated == 16 + 32 + 64);
+    g_assert_true(stats.peak_bytes_allocated == stats.bytes_allocated);
+
+    wmem_free_all(allocator);
+    wmem_alloc(allocator, 8);
+
+    wmem_get_stats(allocator, &stats);
+    g_assert_true(stats.allocs == 1);
+    g_assert_true(stats.bytes_allocated == 8);
+    g_assert_true(stats.peak_bytes_allocated == 16 + 32 + 64);
+
+    wmem_destroy_allocator(allocator);
+}
+
 static void
 wmem_test_allocator_det(wmem_allocator_t *allocator, wmem_verify_func verify,
         guint len)
@@ -1438,6 +1473,7 @@ main(int argc, char **argv)
     g_test_add_func("/wmem/allocator/simple",    wmem_test_allocator_simple);
     g_test_add_func("/wmem/allocator/strict",    wmem_test_allocator_strict);
     g_test_add_func("/wmem/allocator/callbacks", wmem_test_allocator_callbacks);
+    g_test_add_func("/wmem/allocator/stats",     wmem_test_allocator_stats);
 
     g_test_add_func("/wmem/utils/misc",    wmem_test_miscutls);
     g_test_add_func("/wmem/utils/strings", wmem_test_strutls);